@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <EnhancedInput/InputAction.h>
+#include <EnhancedInput/TriggerState.h>
+
+namespace EnhancedInput
+{
+    //! Compact wire format for the action state of one player, one snapshot per simulation frame, for rollback netcode.
+    //! Actions are written in ActionHandle order. Boolean actions take one bit, each axis component a configurable
+    //! number of bits, and trigger states three bits. Only actions whose quantized state differs from the previous
+    //! snapshot are written, behind a one bit per action change mask, and an unchanged frame takes a single byte.
+    //!
+    //! Encoder and decoder each keep the previous snapshot, so a codec instance is used for one direction only and
+    //! snapshots must be decoded in the order they were encoded. Reset both ends together to resynchronize.
+    class ActionSnapshotCodec
+    {
+    public:
+        //! valueTypes holds the type of every action in handle order; both ends must configure the same layout.
+        //! Axis components are clamped to [-axisRange, axisRange] and quantized to bitsPerAxis bits, zero staying exact.
+        void Configure(const AZStd::vector<InputValueType>& valueTypes, AZ::u32 bitsPerAxis = 8, float axisRange = 1.0f);
+        //! Forgets the previous snapshot, so the next one is encoded or decoded against an all-idle frame.
+        void Reset();
+
+        size_t GetActionCount() const { return m_valueTypes.size(); }
+        //! Upper bound of the size of one encoded snapshot.
+        size_t GetMaxSnapshotSize() const { return m_maxSnapshotSize; }
+
+        //! Writes the snapshot of values and triggerStates, each GetActionCount() long, to output. Returns the number
+        //! of bytes written, or 0 if capacity is below GetMaxSnapshotSize().
+        size_t Encode(const InputValue* values, const TriggerState* triggerStates, AZ::u8* output, size_t capacity);
+        //! Reads one snapshot and writes the complete action state it describes to values and triggerStates.
+        //! Returns false if data is too short for the snapshot, in which case the previous snapshot is kept.
+        bool Decode(const AZ::u8* data, size_t size, InputValue* values, TriggerState* triggerStates);
+
+    private:
+        static constexpr AZ::u32 TriggerStateBits = 3;
+
+        AZ::u32 GetComponentCount(ActionHandle action) const;
+        AZ::u32 Quantize(float value) const;
+        float Dequantize(AZ::u32 quantized) const;
+
+        AZStd::vector<InputValueType> m_valueTypes;
+        AZ::u32 m_bitsPerAxis = 8;
+        float m_axisRange = 1.0f;
+        // Quantized steps on either side of zero.
+        AZ::u32 m_axisSteps = 127;
+        float m_quantizeScale = 127.0f;
+        AZStd::vector<AZ::u8> m_componentCounts;
+        AZStd::vector<AZ::u8> m_componentBits;
+        size_t m_maxSnapshotSize = 0;
+
+        // Previous snapshot, quantized: three components per action, and the trigger state.
+        AZStd::vector<AZ::u32> m_previousComponents;
+        AZStd::vector<TriggerState> m_previousTriggerStates;
+        // Sized by Configure, so encoding and decoding never allocate.
+        AZStd::vector<AZ::u32> m_scratchComponents;
+        AZStd::vector<TriggerState> m_scratchTriggerStates;
+        AZStd::vector<AZ::u8> m_scratchChanged;
+    };
+
+} // namespace EnhancedInput
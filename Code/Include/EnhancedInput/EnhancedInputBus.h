@@ -14,30 +14,144 @@
 
 #include <AzCore/EBus/EBus.h>
 #include <AzCore/Interface/Interface.h>
+#include <AzCore/std/containers/vector.h>
 #include <AzCore/std/functional.h>
 
 namespace EnhancedInput
 {
     using InputActionCallback = AZStd::function<void(const InputActionInstance&)>;
 
+    //! One raw channel change from a remote client, as sent over the network.
+    struct RemoteInputEvent
+    {
+        //! Name CRC of the AzFramework::InputChannelId.
+        AZ::u32 m_channelCrc = 0;
+        float m_value = 0.0f;
+        //! Microseconds since the start of the frame; events of a frame are in time order.
+        AZ::u32 m_timeOffsetUs = 0;
+    };
+
+    //! One simulation frame of a remote client: its length and its run of events within the batch's event array.
+    struct RemoteInputFrame
+    {
+        AZ::u32 m_clientId = 0;
+        float m_deltaTime = 0.0f;
+        AZ::u32 m_firstEvent = 0;
+        AZ::u32 m_eventCount = 0;
+    };
+
     class EnhancedInputRequests
     {
     public:
         AZ_RTTI(EnhancedInputRequests, EnhancedInputRequestsTypeId);
         virtual ~EnhancedInputRequests() = default;
 
-        virtual void RegisterAction(const AZStd::string& name, InputValueType valueType = InputValueType::Boolean) = 0;
+        virtual ActionHandle RegisterAction(const AZStd::string& name, InputValueType valueType = InputValueType::Boolean) = 0;
         virtual void UnregisterAction(const AZStd::string& name) = 0;
         virtual const InputAction* GetAction(const AZStd::string& name) const = 0;
+        virtual ActionHandle GetActionHandle(const AZStd::string& name) const = 0;
+        virtual void SetActionConsumesInput(ActionHandle action, bool consume) = 0;
 
         virtual void AddMappingContext(InputMappingContextPtr context, int priority = 0) = 0;
         virtual void RemoveMappingContext(const AZStd::string& contextName) = 0;
         virtual void ClearMappingContexts() = 0;
 
+        //! Context additions and removals are queued and applied together at the start of the next tick.
+        //! Between Begin and the matching Commit they are held back even across ticks, so a batch of changes
+        //! is never observed half applied and costs a single rebuild. Calls may nest.
+        virtual void BeginContextChanges() = 0;
+        virtual void CommitContextChanges() = 0;
+
         virtual void BindAction(const AZStd::string& actionName, TriggerEvent events, InputActionCallback callback) = 0;
+        virtual void BindAction(ActionHandle action, TriggerEvent events, InputActionCallback callback) = 0;
         virtual void UnbindAction(const AZStd::string& actionName) = 0;
 
         virtual const InputActionInstance* GetActionState(const AZStd::string& actionName) const = 0;
+        virtual const InputActionInstance* GetActionState(ActionHandle action) const = 0;
+
+        //! Recomputes an action's value from the freshest channel input, including events received since the last tick.
+        //! Only modifiers run; trigger state and callbacks are left alone. Meant for camera and aim reads right before rendering.
+        virtual InputValue GetLateLatchedActionValue(ActionHandle action) = 0;
+
+        //! With a fixed timestep configured, actions are evaluated once per fixed step rather than once per frame.
+        //! These return how many steps the last tick ran and an action's value as of the end of each of them,
+        //! so simulation substeps can read the input of exactly their step.
+        virtual AZ::u32 GetFixedStepCount() const = 0;
+        virtual InputValue GetFixedStepActionValue(ActionHandle action, AZ::u32 step) const = 0;
+        //! The same for the pipeline of a local user added with AddLocalUser; 0 steps and zero values for any other user.
+        virtual AZ::u32 GetFixedStepCount(AzFramework::LocalUserId localUserId) const = 0;
+        virtual InputValue GetFixedStepActionValue(AzFramework::LocalUserId localUserId, ActionHandle action, AZ::u32 step) const = 0;
+
+        //! Keeps the last capacity state transitions of an action for the queries below; 0 disables the history.
+        //! Storage is sized here, so recording never allocates. Windows are measured back from the latest evaluation.
+        virtual void SetActionHistoryCapacity(ActionHandle action, AZ::u32 capacity) = 0;
+        virtual bool WasTriggeredWithin(ActionHandle action, float seconds) const = 0;
+        //! Seconds since the action last entered the state, or a negative value if it has not since the history was enabled.
+        virtual float TimeSinceLastState(ActionHandle action, TriggerState state) const = 0;
+        //! Consumes the oldest trigger within the window that has not been consumed yet, so a buffered press is acted on once.
+        virtual bool ConsumeBuffered(ActionHandle action, float seconds) = 0;
+        //! The same for the history of a local user added with AddLocalUser; as if the history were empty for any other user.
+        virtual bool WasTriggeredWithin(AzFramework::LocalUserId localUserId, ActionHandle action, float seconds) const = 0;
+        virtual float TimeSinceLastState(AzFramework::LocalUserId localUserId, ActionHandle action, TriggerState state) const = 0;
+        virtual bool ConsumeBuffered(AzFramework::LocalUserId localUserId, ActionHandle action, float seconds) = 0;
+
+        //! Registers an action that triggers when the sequence actions activate one after another, each within maxStepInterval
+        //! seconds of the previous one. Otherwise it is an ordinary action: bind to it or listen for its notifications.
+        //! Steps may be registered later; registering an existing combo name again replaces its sequence.
+        virtual ActionHandle RegisterCombo(const AZStd::string& comboName, const AZStd::vector<AZStd::string>& sequence, float maxStepInterval) = 0;
+
+        //! Gives a local user an action pipeline of their own, so the devices assigned to them drive separate action state.
+        //! Mapping contexts, actions and callbacks stay shared; instances handed to callbacks and notifications carry the user.
+        //! Devices of users without a pipeline drive the default one, which every query not naming a user reads.
+        virtual void AddLocalUser(AzFramework::LocalUserId localUserId) = 0;
+        virtual void RemoveLocalUser(AzFramework::LocalUserId localUserId) = 0;
+        virtual const InputActionInstance* GetLocalUserActionState(AzFramework::LocalUserId localUserId, ActionHandle action) const = 0;
+
+        //! Virtual controllers let AI drive the same actions as players without synthesizing device events. Values are written
+        //! straight into contiguous per-channel or per-action arrays holding one entry per controller, then every controller
+        //! is evaluated through the active bindings' modifiers and triggers in one pass. Results are polled, not notified.
+        //! Changing the controller count clears all values and state.
+        virtual void SetVirtualControllerCount(AZ::u32 count) = 0;
+        //! One value per controller for a channel used by an active binding, or nullptr. Valid until contexts or actions change.
+        virtual float* GetVirtualChannelValues(const AzFramework::InputChannelId& channelId) = 0;
+        //! One value per controller added to the action's value ahead of its triggers, bypassing bindings. Same validity.
+        virtual InputValue* GetVirtualActionValues(ActionHandle action) = 0;
+        virtual void EvaluateVirtualControllers(float deltaTime) = 0;
+        virtual InputValue GetVirtualActionValue(AZ::u32 controller, ActionHandle action) const = 0;
+        virtual TriggerState GetVirtualActionState(AZ::u32 controller, ActionHandle action) const = 0;
+
+        //! Headless evaluation for dedicated servers. Each remote client gets its own pipeline over the shared mapping
+        //! contexts, advanced on its own clock by the frames it sends, with no tick bus or device listener involved.
+        //! Frames are evaluated in the order given, so a batch may carry several frames per client. Results are polled.
+        virtual void AddRemoteClient(AZ::u32 clientId) = 0;
+        virtual void RemoveRemoteClient(AZ::u32 clientId) = 0;
+        virtual void EvaluateRemoteFrames(const AZStd::vector<RemoteInputFrame>& frames, const AZStd::vector<RemoteInputEvent>& events) = 0;
+        virtual const InputActionInstance* GetRemoteClientActionState(AZ::u32 clientId, ActionHandle action) const = 0;
+
+        //! Records every channel event received from devices and every tick's delta time to a file, written in the background.
+        //! The recording opens with the saved state of every pipeline.
+        virtual bool StartInputRecording(const AZStd::string& path) = 0;
+        virtual void StopInputRecording() = 0;
+        //! Drives the pipelines from a recording instead of devices, one recorded tick per tick with its recorded timing,
+        //! until the recording ends. Device input is ignored meanwhile. Not available while the sampling thread runs.
+        //! Pipelines are first put back into their recorded state, which needs the same actions and contexts as when recording.
+        virtual bool StartInputReplay(const AZStd::string& path) = 0;
+        virtual void StopInputReplay() = 0;
+        virtual bool IsReplayingInput() const = 0;
+
+        //! Value type of every action in handle order, the layout to configure an ActionSnapshotCodec with.
+        virtual void GetActionValueTypes(AZStd::vector<InputValueType>& valueTypes) const = 0;
+        //! Copies the values and trigger states of all actions of a local user, in handle order, for snapshot encoding.
+        //! Both are left empty if the user has no pipeline.
+        virtual void CopyActionStates(
+            AzFramework::LocalUserId localUserId, AZStd::vector<InputValue>& values, AZStd::vector<TriggerState>& triggerStates) const = 0;
+
+        //! Copies the complete runtime state of a local user's pipeline into one flat blob: action values and timers,
+        //! trigger internals, channel values, histories and combo progress. Reusing the blob avoids reallocating it.
+        virtual void SaveState(AzFramework::LocalUserId localUserId, AZStd::vector<AZ::u8>& state) const = 0;
+        //! Puts a pipeline back into a saved state, for rollback and resimulation. Queued channel events are dropped.
+        //! Fails if actions, bindings or history capacities changed since the state was saved.
+        virtual bool RestoreState(AzFramework::LocalUserId localUserId, const AZStd::vector<AZ::u8>& state) = 0;
     };
 
     class EnhancedInputBusTraits
@@ -12,11 +12,17 @@
 #include <AzCore/RTTI/RTTI.h>
 #include <AzCore/Serialization/SerializeContext.h>
 #include <AzCore/std/string/string.h>
+#include <AzFramework/Input/User/LocalUserId.h>
 #include <EnhancedInput/InputValue.h>
 #include <EnhancedInput/TriggerState.h>
 
 namespace EnhancedInput
 {
+    //! Dense index of a registered action, returned by EnhancedInputRequests::RegisterAction.
+    //! A handle stays valid until its action is unregistered, after which it may be reused.
+    using ActionHandle = AZ::u32;
+    inline constexpr ActionHandle InvalidActionHandle = static_cast<ActionHandle>(-1);
+
     class InputAction
     {
     public:
@@ -36,6 +42,7 @@ namespace EnhancedInput
         InputValueType GetValueType() const { return m_valueType; }
         void SetValueType(InputValueType type) { m_valueType = type; }
 
+        //! When set, channels bound to this action are hidden from the bindings of lower-priority mapping contexts.
         bool GetConsumeInput() const { return m_consumeInput; }
         void SetConsumeInput(bool consume) { m_consumeInput = consume; }
 
@@ -67,6 +74,8 @@ namespace EnhancedInput
         TriggerState m_triggerState = TriggerState::None;
         float m_elapsedTime = 0.0f;
         float m_triggeredTime = 0.0f;
+        //! User whose pipeline produced this state; LocalUserIdAny for the default pipeline.
+        AzFramework::LocalUserId m_localUserId = AzFramework::LocalUserIdAny;
 
         void Reset()
         {
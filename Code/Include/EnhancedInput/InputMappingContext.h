@@ -31,6 +31,9 @@ namespace EnhancedInput
         AzFramework::InputChannelId m_inputChannelId;
         AZStd::vector<InputModifierPtr> m_modifiers;
         AZStd::vector<InputTriggerPtr> m_triggers;
+        //! Assigned by InputMappingContext::AddBinding and kept while the binding stays in its context, so compiled state
+        //! can follow a binding across edits of the context. Not serialized; 0 for bindings that were not added that way.
+        AZ::u32 m_id = 0;
 
         static void Reflect(AZ::ReflectContext* context);
     };
@@ -55,7 +58,11 @@ namespace EnhancedInput
         void ClearBindings();
 
         const AZStd::vector<InputActionBinding>& GetBindings() const { return m_bindings; }
-        AZStd::vector<InputActionBinding>& GetBindings() { return m_bindings; }
+        AZStd::vector<InputActionBinding>& GetBindings() { ++m_revision; return m_bindings; }
+
+        //! Incremented whenever the bindings may have changed, so compiled lookups built from this context can detect staleness.
+        //! That includes the modifiers of a binding, whose parameters are compiled into a copy.
+        AZ::u32 GetRevision() const { return m_revision; }
 
         AZStd::vector<const InputActionBinding*> GetBindingsForChannel(const AzFramework::InputChannelId& channelId) const;
         AZStd::vector<const InputActionBinding*> GetBindingsForAction(const AZStd::string& actionName) const;
@@ -65,6 +72,8 @@ namespace EnhancedInput
     private:
         AZStd::string m_name;
         AZStd::vector<InputActionBinding> m_bindings;
+        AZ::u32 m_revision = 0;
+        AZ::u32 m_lastBindingId = 0;
     };
 
     struct ActiveMappingContext
@@ -9,13 +9,20 @@
 #pragma once
 
 #include <AzCore/RTTI/RTTI.h>
+#include <AzCore/Math/Matrix3x3.h>
 #include <AzCore/Memory/Memory.h>
 #include <AzCore/Serialization/SerializeContext.h>
+#include <AzCore/std/containers/vector.h>
 #include <AzCore/std/smart_ptr/shared_ptr.h>
 #include <EnhancedInput/InputValue.h>
 
 namespace EnhancedInput
 {
+    class ModifierProgramBuilder;
+
+    //! Bindings are compiled into a flat program that copies each modifier's parameters. The copy is refreshed when the
+    //! context's revision changes, so edit a modifier of an active context only through the context's mutable
+    //! GetBindings(). A modifier changed through a pointer kept elsewhere keeps running with its old parameters.
     class InputModifier
     {
     public:
@@ -26,6 +33,9 @@ namespace EnhancedInput
         virtual ~InputModifier() = default;
 
         virtual InputValue ModifyValue(const InputValue& value) const = 0;
+        //! Emits the ops of this modifier when bindings are compiled. Modifiers that do not override it are called
+        //! through ModifyValue from the compiled program.
+        virtual void Compile(ModifierProgramBuilder& builder) const;
 
         static void Reflect(AZ::ReflectContext* context);
     };
@@ -51,6 +61,7 @@ namespace EnhancedInput
         }
 
         InputValue ModifyValue(const InputValue& value) const override;
+        void Compile(ModifierProgramBuilder& builder) const override;
 
         static void Reflect(AZ::ReflectContext* context);
 
@@ -75,6 +86,7 @@ namespace EnhancedInput
         }
 
         InputValue ModifyValue(const InputValue& value) const override;
+        void Compile(ModifierProgramBuilder& builder) const override;
 
         static void Reflect(AZ::ReflectContext* context);
 
@@ -97,6 +109,7 @@ namespace EnhancedInput
         }
 
         InputValue ModifyValue(const InputValue& value) const override;
+        void Compile(ModifierProgramBuilder& builder) const override;
 
         static void Reflect(AZ::ReflectContext* context);
 
@@ -127,6 +140,7 @@ namespace EnhancedInput
         }
 
         InputValue ModifyValue(const InputValue& value) const override;
+        void Compile(ModifierProgramBuilder& builder) const override;
 
         static void Reflect(AZ::ReflectContext* context);
 
@@ -148,6 +162,7 @@ namespace EnhancedInput
         }
 
         InputValue ModifyValue(const InputValue& value) const override;
+        void Compile(ModifierProgramBuilder& builder) const override;
 
         static void Reflect(AZ::ReflectContext* context);
 
@@ -163,10 +178,55 @@ namespace EnhancedInput
         AZ_CLASS_ALLOCATOR(InputModifierNormalize, AZ::SystemAllocator);
 
         InputValue ModifyValue(const InputValue& value) const override;
+        void Compile(ModifierProgramBuilder& builder) const override;
 
         static void Reflect(AZ::ReflectContext* context);
     };
 
     using InputModifierPtr = AZStd::shared_ptr<InputModifier>;
 
+    enum class ModifierOpCode : AZ::u8
+    {
+        Linear,
+        DeadZoneAxial,
+        DeadZoneRadial,
+        Clamp,
+        Normalize,
+        Custom
+    };
+
+    //! One instruction of a compiled modifier chain. Linear ops multiply by m_matrix, dead zones and clamps read
+    //! their bounds from m_params, and Custom ops call m_modifier.
+    struct ModifierOp
+    {
+        AZ::Matrix3x3 m_matrix = AZ::Matrix3x3::CreateIdentity();
+        float m_params[2] = { 0.0f, 0.0f };
+        const InputModifier* m_modifier = nullptr;
+        ModifierOpCode m_code = ModifierOpCode::Linear;
+    };
+
+    //! Compiles modifier chains into one flat op array. Consecutive Negate, Scale and Swizzle modifiers are all
+    //! linear and fuse into a single matrix; a fused matrix that comes out as identity is dropped.
+    class ModifierProgramBuilder
+    {
+    public:
+        //! Appends to ops; ops already in it are never fused with.
+        explicit ModifierProgramBuilder(AZStd::vector<ModifierOp>& ops);
+
+        void AddChain(const AZStd::vector<InputModifierPtr>& modifiers);
+        void AddLinear(const AZ::Matrix3x3& matrix);
+        void AddOp(ModifierOpCode code, float param0 = 0.0f, float param1 = 0.0f);
+        void AddCustom(const InputModifier* modifier);
+
+        AZ::u32 GetFirstOp() const { return static_cast<AZ::u32>(m_firstOp); }
+        AZ::u32 GetOpCount() const { return static_cast<AZ::u32>(m_ops.size() - m_firstOp); }
+
+    private:
+        AZStd::vector<ModifierOp>& m_ops;
+        size_t m_firstOp = 0;
+    };
+
+    //! Runs a compiled chain; the result matches calling ModifyValue of each modifier in turn.
+    AZ::Vector3 RunModifierProgram(const ModifierOp* ops, AZ::u32 opCount, const InputValue& value);
+
 } // namespace EnhancedInput
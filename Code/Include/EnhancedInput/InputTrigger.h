@@ -17,6 +17,42 @@
 
 namespace EnhancedInput
 {
+    //! Runtime state of one trigger on one binding. Triggers themselves are immutable descriptors, so a mapping
+    //! context can be shared while each evaluator keeps its own states. A value-initialized state is the reset state.
+    struct TriggerRuntimeState
+    {
+        TriggerState m_state = TriggerState::None;
+        float m_elapsedTime = 0.0f;
+        // Timer of deterministic time steps, in place of m_elapsedTime.
+        AZ::s64 m_elapsedUs = 0;
+        // Evaluation time of the last deterministic update, from which the next time step is measured. Kept per trigger,
+        // since bindings of one action may be updated at different times within a frame.
+        AZ::s64 m_updateTimeUs = 0;
+        // Periods a repeating trigger completed in its last update. A step spanning several periods reports Triggered
+        // once; this says how many.
+        AZ::u32 m_periodCount = 0;
+        bool m_wasPressed = false;
+        bool m_hasTriggered = false;
+    };
+
+    //! Time since a trigger's previous update. Deterministic steps are exact differences of integer microsecond
+    //! timestamps of a simulation clock, and timers then count in those instead of accumulating float seconds, so
+    //! the same input gives bit-identical timers and period counts however time is sliced into frames and on every
+    //! machine. What slicing can change is how many updates report Triggered: one update spanning several periods of
+    //! a repeating trigger reports it once, with the number of periods in TriggerRuntimeState::m_periodCount.
+    struct TriggerTimeStep
+    {
+        float m_deltaTime = 0.0f;
+        AZ::s64 m_deltaTimeUs = 0;
+        bool m_isDeterministic = false;
+    };
+
+    //! Durations are converted the same way everywhere, so a float setting maps to one exact number of microseconds.
+    inline AZ::s64 SecondsToMicroseconds(float seconds)
+    {
+        return static_cast<AZ::s64>(static_cast<double>(seconds) * 1000000.0 + (seconds >= 0.0f ? 0.5 : -0.5));
+    }
+
     class InputTrigger
     {
     public:
@@ -26,16 +62,25 @@ namespace EnhancedInput
         InputTrigger() = default;
         virtual ~InputTrigger() = default;
 
-        virtual TriggerState UpdateState(const InputValue& value, float deltaTime) = 0;
-        virtual void Reset() { m_state = TriggerState::None; }
+        virtual TriggerState UpdateState(TriggerRuntimeState& runtimeState, const InputValue& value, const TriggerTimeStep& timeStep) const = 0;
+        //! Updates this trigger for count evaluators at once, skipping those whose isActive flag is 0; states receives
+        //! the result of every active one. One virtual call covers the whole batch, and the built-in triggers run their
+        //! UpdateState inline within it. The default calls UpdateState for each active evaluator.
+        virtual void UpdateStates(TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive, TriggerState* states,
+            AZ::u32 count, const TriggerTimeStep& timeStep) const;
 
-        TriggerState GetState() const { return m_state; }
+        //! True while the trigger has a timer armed and must be updated every frame, even without new input.
+        virtual bool IsTimerRunning([[maybe_unused]] const TriggerRuntimeState& runtimeState) const { return false; }
 
         static void Reflect(AZ::ReflectContext* context);
 
     protected:
-        TriggerState m_state = TriggerState::None;
-        float m_elapsedTime = 0.0f;
+        static void AdvanceTimer(TriggerRuntimeState& runtimeState, const TriggerTimeStep& timeStep);
+        static void ResetTimer(TriggerRuntimeState& runtimeState);
+        static bool HasTimerReached(const TriggerRuntimeState& runtimeState, const TriggerTimeStep& timeStep, float duration);
+        //! Starts the next period of a repeating timer and returns how many periods completed. Deterministic timers count
+        //! every period the step crossed and keep the overshoot, so periods do not drift.
+        static AZ::u32 RestartTimer(TriggerRuntimeState& runtimeState, const TriggerTimeStep& timeStep, float period);
     };
 
     class InputTriggerPressed : public InputTrigger
@@ -44,12 +89,11 @@ namespace EnhancedInput
         AZ_TYPE_INFO(InputTriggerPressed, "{D4E5F6A7-B8C9-0123-4567-89ABCDEF0123}");
         AZ_CLASS_ALLOCATOR(InputTriggerPressed, AZ::SystemAllocator);
 
-        TriggerState UpdateState(const InputValue& value, float deltaTime) override;
+        TriggerState UpdateState(TriggerRuntimeState& runtimeState, const InputValue& value, const TriggerTimeStep& timeStep) const override;
+        void UpdateStates(TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive, TriggerState* states,
+            AZ::u32 count, const TriggerTimeStep& timeStep) const override;
 
         static void Reflect(AZ::ReflectContext* context);
-
-    private:
-        bool m_wasPressed = false;
     };
 
     class InputTriggerReleased : public InputTrigger
@@ -58,12 +102,11 @@ namespace EnhancedInput
         AZ_TYPE_INFO(InputTriggerReleased, "{E5F6A7B8-C9D0-1234-5678-9ABCDEF01234}");
         AZ_CLASS_ALLOCATOR(InputTriggerReleased, AZ::SystemAllocator);
 
-        TriggerState UpdateState(const InputValue& value, float deltaTime) override;
+        TriggerState UpdateState(TriggerRuntimeState& runtimeState, const InputValue& value, const TriggerTimeStep& timeStep) const override;
+        void UpdateStates(TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive, TriggerState* states,
+            AZ::u32 count, const TriggerTimeStep& timeStep) const override;
 
         static void Reflect(AZ::ReflectContext* context);
-
-    private:
-        bool m_wasPressed = false;
     };
 
     class InputTriggerDown : public InputTrigger
@@ -72,12 +115,11 @@ namespace EnhancedInput
         AZ_TYPE_INFO(InputTriggerDown, "{F6A7B8C9-D0E1-2345-6789-ABCDEF012345}");
         AZ_CLASS_ALLOCATOR(InputTriggerDown, AZ::SystemAllocator);
 
-        TriggerState UpdateState(const InputValue& value, float deltaTime) override;
+        TriggerState UpdateState(TriggerRuntimeState& runtimeState, const InputValue& value, const TriggerTimeStep& timeStep) const override;
+        void UpdateStates(TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive, TriggerState* states,
+            AZ::u32 count, const TriggerTimeStep& timeStep) const override;
 
         static void Reflect(AZ::ReflectContext* context);
-
-    private:
-        bool m_wasPressed = false;
     };
 
     class InputTriggerHold : public InputTrigger
@@ -93,8 +135,10 @@ namespace EnhancedInput
         {
         }
 
-        TriggerState UpdateState(const InputValue& value, float deltaTime) override;
-        void Reset() override;
+        TriggerState UpdateState(TriggerRuntimeState& runtimeState, const InputValue& value, const TriggerTimeStep& timeStep) const override;
+        void UpdateStates(TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive, TriggerState* states,
+            AZ::u32 count, const TriggerTimeStep& timeStep) const override;
+        bool IsTimerRunning(const TriggerRuntimeState& runtimeState) const override;
 
         float GetHoldTime() const { return m_holdTime; }
         void SetHoldTime(float time) { m_holdTime = time; }
@@ -104,7 +148,6 @@ namespace EnhancedInput
     private:
         float m_holdTime = 0.5f;
         bool m_triggerOnce = false;
-        bool m_hasTriggered = false;
     };
 
     class InputTriggerTap : public InputTrigger
@@ -119,14 +162,15 @@ namespace EnhancedInput
         {
         }
 
-        TriggerState UpdateState(const InputValue& value, float deltaTime) override;
-        void Reset() override;
+        TriggerState UpdateState(TriggerRuntimeState& runtimeState, const InputValue& value, const TriggerTimeStep& timeStep) const override;
+        void UpdateStates(TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive, TriggerState* states,
+            AZ::u32 count, const TriggerTimeStep& timeStep) const override;
+        bool IsTimerRunning(const TriggerRuntimeState& runtimeState) const override;
 
         static void Reflect(AZ::ReflectContext* context);
 
     private:
         float m_maxTapTime = 0.2f;
-        bool m_wasPressed = false;
     };
 
     class InputTriggerPulse : public InputTrigger
@@ -142,16 +186,16 @@ namespace EnhancedInput
         {
         }
 
-        TriggerState UpdateState(const InputValue& value, float deltaTime) override;
-        void Reset() override;
+        TriggerState UpdateState(TriggerRuntimeState& runtimeState, const InputValue& value, const TriggerTimeStep& timeStep) const override;
+        void UpdateStates(TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive, TriggerState* states,
+            AZ::u32 count, const TriggerTimeStep& timeStep) const override;
+        bool IsTimerRunning(const TriggerRuntimeState& runtimeState) const override;
 
         static void Reflect(AZ::ReflectContext* context);
 
     private:
         float m_interval = 0.1f;
         bool m_triggerOnStart = true;
-        float m_timeSinceLastTrigger = 0.0f;
-        bool m_isFirstTrigger = true;
     };
 
     using InputTriggerPtr = AZStd::shared_ptr<InputTrigger>;
@@ -1,4 +1,4 @@
 
 set(PAL_TRAIT_ENHANCEDINPUT_SUPPORTED TRUE)
-set(PAL_TRAIT_ENHANCEDINPUT_TEST_SUPPORTED FALSE)
+set(PAL_TRAIT_ENHANCEDINPUT_TEST_SUPPORTED TRUE)
 set(PAL_TRAIT_ENHANCEDINPUT_EDITOR_TEST_SUPPORTED FALSE)
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "ActionHistory.h"
+
+namespace EnhancedInput
+{
+    void ActionHistory::SetCapacity(AZ::u32 capacity)
+    {
+        m_records.clear();
+        m_records.resize(capacity);
+        Clear();
+    }
+
+    void ActionHistory::Clear()
+    {
+        m_head = 0;
+        m_count = 0;
+        m_lastStateTimes.fill(0);
+    }
+
+    void ActionHistory::SaveState(StateBlobWriter& writer) const
+    {
+        writer.Write(GetCapacity());
+        writer.Write(m_head);
+        writer.Write(m_count);
+        writer.Write(m_lastStateTimes);
+        writer.WriteArray(m_records);
+    }
+
+    bool ActionHistory::RestoreState(StateBlobReader& reader)
+    {
+        AZ::u32 capacity = 0;
+        if (!reader.Read(capacity) || capacity != GetCapacity())
+        {
+            return false;
+        }
+        return reader.Read(m_head) && reader.Read(m_count) && reader.Read(m_lastStateTimes) && reader.ReadArray(m_records);
+    }
+
+    void ActionHistory::Record(AZStd::sys_time_t timeUs, TriggerState state, const InputValue& value, float elapsedTime)
+    {
+        if (m_records.empty())
+        {
+            return;
+        }
+
+        const AZ::u32 capacity = GetCapacity();
+        if (m_count == capacity)
+        {
+            m_head = (m_head + 1) % capacity;
+            --m_count;
+        }
+
+        ActionHistoryRecord& record = At(m_count);
+        record.m_timeUs = timeUs;
+        record.m_value = value;
+        record.m_elapsedTime = elapsedTime;
+        record.m_triggerState = state;
+        record.m_consumed = false;
+        ++m_count;
+
+        m_lastStateTimes[static_cast<size_t>(state)] = timeUs;
+    }
+
+    bool ActionHistory::ConsumeTriggered(AZStd::sys_time_t sinceUs)
+    {
+        for (AZ::u32 index = FindFirstAtOrAfter(sinceUs); index < m_count; ++index)
+        {
+            ActionHistoryRecord& record = At(index);
+            if (record.m_triggerState == TriggerState::Triggered && !record.m_consumed)
+            {
+                record.m_consumed = true;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    AZ::u32 ActionHistory::FindFirstAtOrAfter(AZStd::sys_time_t timeUs) const
+    {
+        AZ::u32 first = 0;
+        AZ::u32 last = m_count;
+        while (first < last)
+        {
+            const AZ::u32 middle = first + (last - first) / 2;
+            if ((*this)[middle].m_timeUs < timeUs)
+            {
+                first = middle + 1;
+            }
+            else
+            {
+                last = middle;
+            }
+        }
+        return first;
+    }
+
+} // namespace EnhancedInput
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/time.h>
+#include <EnhancedInput/InputValue.h>
+#include <EnhancedInput/TriggerState.h>
+
+#include "AllocationTracker.h"
+#include "StateBlob.h"
+
+namespace EnhancedInput
+{
+    struct ActionHistoryRecord
+    {
+        AZStd::sys_time_t m_timeUs = 0;
+        InputValue m_value;
+        float m_elapsedTime = 0.0f;
+        TriggerState m_triggerState = TriggerState::None;
+        bool m_consumed = false;
+    };
+
+    //! Fixed-capacity ring of one action's timestamped state transitions, for input buffering and coyote time.
+    //! Storage is sized by SetCapacity, so recording never allocates. Records are in time order, which lets
+    //! window lookups binary search instead of scanning.
+    class ActionHistory
+    {
+    public:
+        static constexpr size_t StateCount = static_cast<size_t>(TriggerState::Canceled) + 1;
+
+        void SetCapacity(AZ::u32 capacity);
+        AZ::u32 GetCapacity() const { return static_cast<AZ::u32>(m_records.size()); }
+        AZ::u32 GetSize() const { return m_count; }
+        void Clear();
+
+        void Record(AZStd::sys_time_t timeUs, TriggerState state, const InputValue& value, float elapsedTime);
+
+        //! Record at the given age, index 0 being the oldest still held.
+        const ActionHistoryRecord& operator[](AZ::u32 index) const { return m_records[(m_head + index) % m_records.size()]; }
+
+        //! Time the action last entered the state, or 0 if it never did since the history was enabled.
+        AZStd::sys_time_t GetLastStateTime(TriggerState state) const { return m_lastStateTimes[static_cast<size_t>(state)]; }
+
+        //! Marks the oldest unconsumed Triggered record at or after sinceUs as consumed. Returns false if there is none.
+        bool ConsumeTriggered(AZStd::sys_time_t sinceUs);
+
+        void SaveState(StateBlobWriter& writer) const;
+        //! Fails, leaving the history untouched, unless it had the same capacity when the state was saved.
+        bool RestoreState(StateBlobReader& reader);
+
+    private:
+        AZ::u32 FindFirstAtOrAfter(AZStd::sys_time_t timeUs) const;
+
+        ActionHistoryRecord& At(AZ::u32 index) { return m_records[(m_head + index) % m_records.size()]; }
+
+        RuntimeVector<ActionHistoryRecord> m_records;
+        AZ::u32 m_head = 0;
+        AZ::u32 m_count = 0;
+        AZStd::array<AZStd::sys_time_t, StateCount> m_lastStateTimes = {};
+    };
+
+} // namespace EnhancedInput
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include <EnhancedInput/ActionSnapshotCodec.h>
+
+#include <AzCore/Math/MathUtils.h>
+
+namespace EnhancedInput
+{
+    namespace
+    {
+        class BitWriter
+        {
+        public:
+            explicit BitWriter(AZ::u8* output)
+                : m_output(output)
+            {
+            }
+
+            void Write(AZ::u32 value, AZ::u32 bitCount)
+            {
+                m_bits |= static_cast<AZ::u64>(value) << m_bitCount;
+                m_bitCount += bitCount;
+                while (m_bitCount >= 8)
+                {
+                    m_output[m_size++] = static_cast<AZ::u8>(m_bits);
+                    m_bits >>= 8;
+                    m_bitCount -= 8;
+                }
+            }
+
+            size_t Finish()
+            {
+                if (m_bitCount > 0)
+                {
+                    m_output[m_size++] = static_cast<AZ::u8>(m_bits);
+                    m_bits = 0;
+                    m_bitCount = 0;
+                }
+                return m_size;
+            }
+
+        private:
+            AZ::u8* m_output = nullptr;
+            size_t m_size = 0;
+            AZ::u64 m_bits = 0;
+            AZ::u32 m_bitCount = 0;
+        };
+
+        class BitReader
+        {
+        public:
+            BitReader(const AZ::u8* data, size_t size)
+                : m_data(data)
+                , m_size(size)
+            {
+            }
+
+            //! Returns false once the data runs out; the value is then zero filled.
+            bool Read(AZ::u32 bitCount, AZ::u32& value)
+            {
+                while (m_bitCount < bitCount && m_offset < m_size)
+                {
+                    m_bits |= static_cast<AZ::u64>(m_data[m_offset++]) << m_bitCount;
+                    m_bitCount += 8;
+                }
+
+                value = static_cast<AZ::u32>(m_bits & ((AZ::u64(1) << bitCount) - 1));
+                if (m_bitCount < bitCount)
+                {
+                    return false;
+                }
+                m_bits >>= bitCount;
+                m_bitCount -= bitCount;
+                return true;
+            }
+
+        private:
+            const AZ::u8* m_data = nullptr;
+            size_t m_size = 0;
+            size_t m_offset = 0;
+            AZ::u64 m_bits = 0;
+            AZ::u32 m_bitCount = 0;
+        };
+    } // namespace
+
+    void ActionSnapshotCodec::Configure(const AZStd::vector<InputValueType>& valueTypes, AZ::u32 bitsPerAxis, float axisRange)
+    {
+        AZ_Warning("EnhancedInput", bitsPerAxis >= 2 && bitsPerAxis <= 24, "Snapshot axis precision of %u bits clamped to [2, 24].", bitsPerAxis);
+        m_valueTypes = valueTypes;
+        m_bitsPerAxis = AZ::GetClamp(bitsPerAxis, 2u, 24u);
+        m_axisRange = axisRange > 0.0f ? axisRange : 1.0f;
+        m_axisSteps = (1u << (m_bitsPerAxis - 1)) - 1;
+
+        m_quantizeScale = static_cast<float>(m_axisSteps) / m_axisRange;
+
+        // Per-action layout is resolved once here, so encoding is straight-line arithmetic.
+        m_componentCounts.resize(m_valueTypes.size());
+        m_componentBits.resize(m_valueTypes.size());
+        size_t maxBits = 1 + m_valueTypes.size();
+        for (ActionHandle action = 0; action < m_valueTypes.size(); ++action)
+        {
+            m_componentCounts[action] = static_cast<AZ::u8>(GetComponentCount(action));
+            m_componentBits[action] = static_cast<AZ::u8>(m_valueTypes[action] == InputValueType::Boolean ? 1 : m_bitsPerAxis);
+            maxBits += TriggerStateBits + m_componentCounts[action] * m_componentBits[action];
+        }
+        m_maxSnapshotSize = (maxBits + 7) / 8;
+
+        Reset();
+    }
+
+    void ActionSnapshotCodec::Reset()
+    {
+        m_previousComponents.assign(m_valueTypes.size() * 3, Quantize(0.0f));
+        m_previousTriggerStates.assign(m_valueTypes.size(), TriggerState::None);
+        m_scratchComponents.resize(m_previousComponents.size());
+        m_scratchTriggerStates.resize(m_previousTriggerStates.size());
+        m_scratchChanged.resize(m_valueTypes.size());
+        for (ActionHandle action = 0; action < m_valueTypes.size(); ++action)
+        {
+            if (m_valueTypes[action] == InputValueType::Boolean)
+            {
+                m_previousComponents[action * 3] = 0;
+            }
+        }
+    }
+
+    size_t ActionSnapshotCodec::Encode(const InputValue* values, const TriggerState* triggerStates, AZ::u8* output, size_t capacity)
+    {
+        if (capacity < m_maxSnapshotSize)
+        {
+            return 0;
+        }
+
+        // Quantize everything first, so the change mask can precede the payloads.
+        const size_t actionCount = m_valueTypes.size();
+        bool anyChanged = false;
+        for (ActionHandle action = 0; action < actionCount; ++action)
+        {
+            AZ::u32* components = &m_scratchComponents[action * 3];
+            const AZ::Vector3& data = values[action].m_data;
+            if (m_valueTypes[action] == InputValueType::Boolean)
+            {
+                components[0] = data.GetX() != 0.0f ? 1u : 0u;
+            }
+            else
+            {
+                for (AZ::u32 component = 0; component < m_componentCounts[action]; ++component)
+                {
+                    components[component] = Quantize(data.GetElement(component));
+                }
+            }
+
+            bool changed = triggerStates[action] != m_previousTriggerStates[action];
+            for (AZ::u32 component = 0; component < m_componentCounts[action]; ++component)
+            {
+                changed |= components[component] != m_previousComponents[action * 3 + component];
+            }
+            m_scratchChanged[action] = changed ? 1 : 0;
+            anyChanged |= changed;
+        }
+
+        BitWriter writer(output);
+        writer.Write(anyChanged ? 1 : 0, 1);
+        if (!anyChanged)
+        {
+            return writer.Finish();
+        }
+
+        for (ActionHandle action = 0; action < actionCount; ++action)
+        {
+            writer.Write(m_scratchChanged[action], 1);
+        }
+
+        for (ActionHandle action = 0; action < actionCount; ++action)
+        {
+            if (!m_scratchChanged[action])
+            {
+                continue;
+            }
+
+            writer.Write(static_cast<AZ::u32>(triggerStates[action]), TriggerStateBits);
+            m_previousTriggerStates[action] = triggerStates[action];
+
+            for (AZ::u32 component = 0; component < m_componentCounts[action]; ++component)
+            {
+                const AZ::u32 quantized = m_scratchComponents[action * 3 + component];
+                writer.Write(quantized, m_componentBits[action]);
+                m_previousComponents[action * 3 + component] = quantized;
+            }
+        }
+
+        return writer.Finish();
+    }
+
+    bool ActionSnapshotCodec::Decode(const AZ::u8* data, size_t size, InputValue* values, TriggerState* triggerStates)
+    {
+        const size_t actionCount = m_valueTypes.size();
+        BitReader reader(data, size);
+
+        AZ::u32 anyChanged = 0;
+        if (!reader.Read(1, anyChanged))
+        {
+            return false;
+        }
+
+        if (anyChanged)
+        {
+            for (ActionHandle action = 0; action < actionCount; ++action)
+            {
+                AZ::u32 changed = 0;
+                if (!reader.Read(1, changed))
+                {
+                    return false;
+                }
+                m_scratchChanged[action] = static_cast<AZ::u8>(changed);
+            }
+
+            // Decoded into scratch first, so a truncated snapshot leaves the previous one intact.
+            AZStd::copy(m_previousComponents.begin(), m_previousComponents.end(), m_scratchComponents.begin());
+            AZStd::copy(m_previousTriggerStates.begin(), m_previousTriggerStates.end(), m_scratchTriggerStates.begin());
+            for (ActionHandle action = 0; action < actionCount; ++action)
+            {
+                if (!m_scratchChanged[action])
+                {
+                    continue;
+                }
+
+                AZ::u32 state = 0;
+                if (!reader.Read(TriggerStateBits, state))
+                {
+                    return false;
+                }
+                m_scratchTriggerStates[action] = static_cast<TriggerState>(state);
+
+                for (AZ::u32 component = 0; component < m_componentCounts[action]; ++component)
+                {
+                    if (!reader.Read(m_componentBits[action], m_scratchComponents[action * 3 + component]))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            AZStd::swap(m_previousComponents, m_scratchComponents);
+            AZStd::swap(m_previousTriggerStates, m_scratchTriggerStates);
+        }
+
+        for (ActionHandle action = 0; action < actionCount; ++action)
+        {
+            const AZ::u32* quantized = &m_previousComponents[action * 3];
+            switch (m_valueTypes[action])
+            {
+            case InputValueType::Boolean:
+                values[action] = InputValue(quantized[0] != 0);
+                break;
+            case InputValueType::Axis1D:
+                values[action] = InputValue(Dequantize(quantized[0]));
+                break;
+            case InputValueType::Axis2D:
+                values[action] = InputValue(AZ::Vector2(Dequantize(quantized[0]), Dequantize(quantized[1])));
+                break;
+            case InputValueType::Axis3D:
+                values[action] = InputValue(AZ::Vector3(Dequantize(quantized[0]), Dequantize(quantized[1]), Dequantize(quantized[2])));
+                break;
+            }
+            triggerStates[action] = m_previousTriggerStates[action];
+        }
+        return true;
+    }
+
+    AZ::u32 ActionSnapshotCodec::GetComponentCount(ActionHandle action) const
+    {
+        switch (m_valueTypes[action])
+        {
+        case InputValueType::Axis2D:
+            return 2;
+        case InputValueType::Axis3D:
+            return 3;
+        default:
+            return 1;
+        }
+    }
+
+    AZ::u32 ActionSnapshotCodec::Quantize(float value) const
+    {
+        const float steps = static_cast<float>(m_axisSteps);
+        const float scaled = AZ::GetClamp(value * m_quantizeScale, -steps, steps);
+        return static_cast<AZ::u32>(static_cast<AZ::s32>(scaled + (scaled >= 0.0f ? 0.5f : -0.5f)) + static_cast<AZ::s32>(m_axisSteps));
+    }
+
+    float ActionSnapshotCodec::Dequantize(AZ::u32 quantized) const
+    {
+        const AZ::s32 steps = static_cast<AZ::s32>(quantized) - static_cast<AZ::s32>(m_axisSteps);
+        return static_cast<float>(steps) / static_cast<float>(m_axisSteps) * m_axisRange;
+    }
+
+} // namespace EnhancedInput
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "ActionStateStorage.h"
+
+namespace EnhancedInput
+{
+    void ActionStateStorage::Resize(size_t count)
+    {
+        m_values.resize(count);
+        m_previousValues.resize(count);
+        m_triggerStates.resize(count, TriggerState::None);
+        m_elapsedTimes.resize(count, 0.0f);
+        m_triggeredTimes.resize(count, 0.0f);
+        m_substepTimes.resize(count, 0.0f);
+        m_hasRunningTimer.resize(count, 0);
+        m_registered.resize(count, 0);
+        m_dirty.resize(count, 0);
+    }
+
+    void ActionStateStorage::ResetSlot(ActionHandle handle)
+    {
+        m_values[handle] = InputValue();
+        m_previousValues[handle] = InputValue();
+        m_triggerStates[handle] = TriggerState::None;
+        m_elapsedTimes[handle] = 0.0f;
+        m_triggeredTimes[handle] = 0.0f;
+        m_substepTimes[handle] = 0.0f;
+        m_hasRunningTimer[handle] = 0;
+        m_registered[handle] = 0;
+    }
+
+    void ActionStateStorage::Clear()
+    {
+        m_values.clear();
+        m_previousValues.clear();
+        m_triggerStates.clear();
+        m_elapsedTimes.clear();
+        m_triggeredTimes.clear();
+        m_substepTimes.clear();
+        m_hasRunningTimer.clear();
+        m_registered.clear();
+        m_dirty.clear();
+    }
+
+    void ActionStateStorage::SaveState(StateBlobWriter& writer) const
+    {
+        writer.WriteArray(m_values);
+        writer.WriteArray(m_previousValues);
+        writer.WriteArray(m_triggerStates);
+        writer.WriteArray(m_elapsedTimes);
+        writer.WriteArray(m_triggeredTimes);
+        writer.WriteArray(m_hasRunningTimer);
+    }
+
+    bool ActionStateStorage::RestoreState(StateBlobReader& reader)
+    {
+        AZStd::fill(m_substepTimes.begin(), m_substepTimes.end(), 0.0f);
+        return reader.ReadArray(m_values) && reader.ReadArray(m_previousValues) && reader.ReadArray(m_triggerStates) &&
+            reader.ReadArray(m_elapsedTimes) && reader.ReadArray(m_triggeredTimes) && reader.ReadArray(m_hasRunningTimer);
+    }
+
+    void ActionStateStorage::BuildInstance(ActionHandle handle, const InputAction* action, InputActionInstance& instance) const
+    {
+        instance.m_action = action;
+        instance.m_value = m_values[handle];
+        instance.m_previousValue = m_previousValues[handle];
+        instance.m_triggerState = m_triggerStates[handle];
+        instance.m_elapsedTime = m_elapsedTimes[handle];
+        instance.m_triggeredTime = m_triggeredTimes[handle];
+    }
+
+} // namespace EnhancedInput
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <EnhancedInput/InputAction.h>
+
+#include "AllocationTracker.h"
+#include "StateBlob.h"
+
+namespace EnhancedInput
+{
+    //! Runtime state of every registered action, stored as parallel arrays indexed by ActionHandle
+    //! so the per-frame reset and finalize passes are linear scans over contiguous memory.
+    class ActionStateStorage
+    {
+    public:
+        size_t GetSize() const { return m_values.size(); }
+
+        void Resize(size_t count);
+        void ResetSlot(ActionHandle handle);
+        void Clear();
+
+        //! Assembles the AoS view handed to callbacks, notification handlers and GetActionState.
+        void BuildInstance(ActionHandle handle, const InputAction* action, InputActionInstance& instance) const;
+
+        //! Action values, trigger states and timers. Registration and the dirty set are left as they are.
+        void SaveState(StateBlobWriter& writer) const;
+        bool RestoreState(StateBlobReader& reader);
+
+        RuntimeVector<InputValue> m_values;
+        RuntimeVector<InputValue> m_previousValues;
+        RuntimeVector<TriggerState> m_triggerStates;
+        RuntimeVector<float> m_elapsedTimes;
+        RuntimeVector<float> m_triggeredTimes;
+        //! Seconds of the current tick already consumed by sub-frame evaluations.
+        RuntimeVector<float> m_substepTimes;
+        RuntimeVector<AZ::u8> m_hasRunningTimer;
+        RuntimeVector<AZ::u8> m_registered;
+        //! Membership flag for the system's dirty list. Not touched by ResetSlot, since the handle may still be queued.
+        RuntimeVector<AZ::u8> m_dirty;
+    };
+
+} // namespace EnhancedInput
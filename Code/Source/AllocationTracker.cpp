@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "AllocationTracker.h"
+
+namespace EnhancedInput
+{
+    namespace
+    {
+        thread_local AZ::u32 s_allocationCount = 0;
+    } // namespace
+
+    AllocationTrackingScope::AllocationTrackingScope()
+        : m_startCount(s_allocationCount)
+    {
+    }
+
+    AZ::u32 AllocationTrackingScope::GetAllocationCount() const
+    {
+        return s_allocationCount - m_startCount;
+    }
+
+    void AllocationTrackingScope::RecordAllocation()
+    {
+        ++s_allocationCount;
+    }
+
+} // namespace EnhancedInput
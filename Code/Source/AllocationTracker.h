@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/base.h>
+#include <AzCore/std/allocator.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace EnhancedInput
+{
+    //! Counts the allocations made through RuntimeAllocator on the current thread while the scope is alive.
+    //! Used to verify that steady-state ticks never grow the gem's runtime containers. Allocations through any other
+    //! allocator, such as containers using the default one, job objects or EBus dispatch, are not seen.
+    class AllocationTrackingScope
+    {
+    public:
+        AllocationTrackingScope();
+        AZ_DISABLE_COPY_MOVE(AllocationTrackingScope);
+
+        AZ::u32 GetAllocationCount() const;
+
+        static void RecordAllocation();
+
+    private:
+        AZ::u32 m_startCount = 0;
+    };
+
+    //! AZStd allocator for the containers touched by the tick. Forwards to the default allocator and reports each
+    //! allocation to AllocationTrackingScope.
+    class RuntimeAllocator
+        : public AZStd::allocator
+    {
+    public:
+        using AZStd::allocator::allocator;
+
+        pointer allocate(size_type byteSize, size_type alignment, [[maybe_unused]] int flags = 0)
+        {
+            AllocationTrackingScope::RecordAllocation();
+            return AZStd::allocator::allocate(byteSize, alignment);
+        }
+    };
+
+    template<typename T>
+    using RuntimeVector = AZStd::vector<T, RuntimeAllocator>;
+
+} // namespace EnhancedInput
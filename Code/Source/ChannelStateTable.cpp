@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "ChannelStateTable.h"
+
+namespace EnhancedInput
+{
+    ChannelIndex ChannelIndexMap::RegisterChannel(AZ::Crc32 channelCrc)
+    {
+        auto it = m_channelIndices.find(channelCrc);
+        if (it != m_channelIndices.end())
+        {
+            return it->second;
+        }
+
+        const ChannelIndex channel = GetChannelCount();
+        m_channelIndices.emplace(channelCrc, channel);
+        m_channelCrcs.push_back(channelCrc);
+        return channel;
+    }
+
+    ChannelIndex ChannelIndexMap::FindChannel(AZ::Crc32 channelCrc) const
+    {
+        auto it = m_channelIndices.find(channelCrc);
+        return it != m_channelIndices.end() ? it->second : InvalidChannelIndex;
+    }
+
+    void ChannelStateTable::Resize(ChannelIndex count)
+    {
+        if (count <= m_values.size())
+        {
+            return;
+        }
+
+        m_values.resize(count, 0.0f);
+        m_changedBits.resize((count + 63) / 64, 0);
+        // Each channel can appear in the changed list at most once per tick, so this keeps SetValue allocation free.
+        m_changedChannels.reserve(count);
+    }
+
+    void ChannelStateTable::SetValue(ChannelIndex channel, float value)
+    {
+        m_values[channel] = value;
+
+        AZ::u64& word = m_changedBits[channel / 64];
+        const AZ::u64 bit = AZ::u64(1) << (channel % 64);
+        if ((word & bit) == 0)
+        {
+            word |= bit;
+            m_changedChannels.push_back(channel);
+        }
+    }
+
+    bool ChannelStateTable::HasChanged(ChannelIndex channel) const
+    {
+        return (m_changedBits[channel / 64] & (AZ::u64(1) << (channel % 64))) != 0;
+    }
+
+    void ChannelStateTable::ClearChanged()
+    {
+        for (const ChannelIndex channel : m_changedChannels)
+        {
+            m_changedBits[channel / 64] = 0;
+        }
+        m_changedChannels.clear();
+    }
+
+    void ChannelStateTable::SaveState(StateBlobWriter& writer) const
+    {
+        writer.WriteArray(m_values);
+    }
+
+    bool ChannelStateTable::RestoreState(StateBlobReader& reader)
+    {
+        ClearChanged();
+        return reader.ReadArray(m_values);
+    }
+
+    void ChannelStateTable::Clear()
+    {
+        m_values.clear();
+        m_changedBits.clear();
+        m_changedChannels.clear();
+    }
+
+} // namespace EnhancedInput
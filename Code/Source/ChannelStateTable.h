@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/Math/Crc.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+
+#include "AllocationTracker.h"
+#include "StateBlob.h"
+
+namespace EnhancedInput
+{
+    using ChannelIndex = AZ::u32;
+    inline constexpr ChannelIndex InvalidChannelIndex = static_cast<ChannelIndex>(-1);
+
+    //! Dense indices of the input channels referenced by any binding, shared by the channel tables of every pipeline.
+    //! Indices are handed out once and never reassigned, so held state survives context changes.
+    class ChannelIndexMap
+    {
+    public:
+        ChannelIndex RegisterChannel(AZ::Crc32 channelCrc);
+        ChannelIndex FindChannel(AZ::Crc32 channelCrc) const;
+        AZ::Crc32 GetChannelCrc(ChannelIndex channel) const { return m_channelCrcs[channel]; }
+        ChannelIndex GetChannelCount() const { return static_cast<ChannelIndex>(m_channelCrcs.size()); }
+
+        void Clear()
+        {
+            m_channelIndices.clear();
+            m_channelCrcs.clear();
+        }
+
+    private:
+        AZStd::unordered_map<AZ::Crc32, ChannelIndex> m_channelIndices;
+        AZStd::vector<AZ::Crc32> m_channelCrcs;
+    };
+
+    //! Last known value of every input channel referenced by a binding, indexed by ChannelIndexMap indices.
+    //! Values persist across ticks, so a held channel keeps driving its actions without new events.
+    class ChannelStateTable
+    {
+    public:
+        //! Grows the table to cover count channels; existing values are kept.
+        void Resize(ChannelIndex count);
+        ChannelIndex GetChannelCount() const { return static_cast<ChannelIndex>(m_values.size()); }
+
+        void SetValue(ChannelIndex channel, float value);
+        float GetValue(ChannelIndex channel) const { return m_values[channel]; }
+
+        bool HasChanged(ChannelIndex channel) const;
+        const RuntimeVector<ChannelIndex>& GetChangedChannels() const { return m_changedChannels; }
+        void ClearChanged();
+
+        void Clear();
+
+        //! Channel values only; a restored table reports no changes.
+        void SaveState(StateBlobWriter& writer) const;
+        bool RestoreState(StateBlobReader& reader);
+
+    private:
+        RuntimeVector<float> m_values;
+        RuntimeVector<AZ::u64> m_changedBits;
+        RuntimeVector<ChannelIndex> m_changedChannels;
+    };
+
+} // namespace EnhancedInput
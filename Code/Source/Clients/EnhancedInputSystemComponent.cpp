@@ -19,12 +19,74 @@
 
 #include <AzCore/Serialization/SerializeContext.h>
 #include <AzCore/RTTI/BehaviorContext.h>
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/sort.h>
 #include <AzFramework/Input/Devices/Keyboard/InputDeviceKeyboard.h>
 #include <AzFramework/Input/Devices/Mouse/InputDeviceMouse.h>
 #include <AzFramework/Input/Devices/Gamepad/InputDeviceGamepad.h>
 
+#include "ModifierBatch.h"
+
 namespace EnhancedInput
 {
+    namespace
+    {
+        void FlattenDispatchEntries(
+            const AZStd::vector<AZStd::vector<DispatchEntry>>& groupedEntries,
+            AZStd::vector<DispatchRange>& ranges,
+            AZStd::vector<DispatchEntry>& entries)
+        {
+            ranges.clear();
+            entries.clear();
+            ranges.resize(groupedEntries.size());
+
+            for (size_t group = 0; group < groupedEntries.size(); ++group)
+            {
+                ranges[group].m_first = static_cast<AZ::u32>(entries.size());
+                ranges[group].m_count = static_cast<AZ::u32>(groupedEntries[group].size());
+                entries.insert(entries.end(), groupedEntries[group].begin(), groupedEntries[group].end());
+            }
+        }
+
+        bool IsActiveState(TriggerState state)
+        {
+            return state == TriggerState::Started || state == TriggerState::Ongoing || state == TriggerState::Triggered;
+        }
+
+        // Leads every saved pipeline state, so a state only restores into a pipeline of the same shape.
+        struct PipelineStateLayout
+        {
+            AZ::u32 m_actionCount = 0;
+            AZ::u32 m_channelCount = 0;
+            AZ::u32 m_triggerSlotCount = 0;
+            AZ::u32 m_comboStepCapacity = 0;
+            AZ::u32 m_historyCapacity = 0;
+
+            bool operator==(const PipelineStateLayout& other) const
+            {
+                return m_actionCount == other.m_actionCount && m_channelCount == other.m_channelCount &&
+                    m_triggerSlotCount == other.m_triggerSlotCount && m_comboStepCapacity == other.m_comboStepCapacity &&
+                    m_historyCapacity == other.m_historyCapacity;
+            }
+        };
+
+        PipelineStateLayout GetPipelineStateLayout(const InputPipeline& pipeline)
+        {
+            PipelineStateLayout layout;
+            layout.m_actionCount = static_cast<AZ::u32>(pipeline.m_actionStates.GetSize());
+            layout.m_channelCount = pipeline.m_channelStates.GetChannelCount();
+            layout.m_triggerSlotCount = static_cast<AZ::u32>(pipeline.m_triggerStates.size());
+            layout.m_comboStepCapacity = static_cast<AZ::u32>(pipeline.m_comboMatchState.m_activationTimes.size());
+            for (const ActionHistory& history : pipeline.m_actionHistories)
+            {
+                layout.m_historyCapacity += history.GetCapacity();
+            }
+            return layout;
+        }
+    } // namespace
 
     AZ_COMPONENT_IMPL(EnhancedInputSystemComponent, "EnhancedInputSystemComponent",
         EnhancedInputSystemComponentTypeId);
@@ -56,7 +118,16 @@ namespace EnhancedInput
         if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
         {
             serializeContext->Class<EnhancedInputSystemComponent, AZ::Component>()
-                ->Version(1);
+                ->Version(8)
+                ->Field("IncrementalTick", &EnhancedInputSystemComponent::m_incrementalTick)
+                ->Field("TrackTickAllocations", &EnhancedInputSystemComponent::m_trackTickAllocations)
+                ->Field("DeterministicTiming", &EnhancedInputSystemComponent::m_deterministicTiming)
+                ->Field("UseSamplingThread", &EnhancedInputSystemComponent::m_useSamplingThread)
+                ->Field("SamplingRateHz", &EnhancedInputSystemComponent::m_samplingRateHz)
+                ->Field("FixedTimestep", &EnhancedInputSystemComponent::m_fixedTimestep)
+                ->Field("MaxFixedSteps", &EnhancedInputSystemComponent::m_maxFixedSteps)
+                ->Field("DefaultHistoryCapacity", &EnhancedInputSystemComponent::m_defaultHistoryCapacity)
+                ->Field("MinParallelPipelines", &EnhancedInputSystemComponent::m_minParallelPipelines);
         }
 
         if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
@@ -92,6 +163,7 @@ namespace EnhancedInput
                 ->Property("Value", [](const InputActionInstance* self) { return self->m_value; }, nullptr)
                 ->Property("ElapsedTime", [](const InputActionInstance* self) { return self->m_elapsedTime; }, nullptr)
                 ->Property("TriggeredTime", [](const InputActionInstance* self) { return self->m_triggeredTime; }, nullptr)
+                ->Property("LocalUserId", [](const InputActionInstance* self) { return static_cast<AZ::u32>(self->m_localUserId); }, nullptr)
                 ->Method("IsTriggered", &InputActionInstance::IsTriggered)
                 ->Method("IsOngoing", &InputActionInstance::IsOngoing)
                 ->Method("IsCompleted", &InputActionInstance::IsCompleted)
@@ -137,7 +209,41 @@ namespace EnhancedInput
                 ->Attribute(AZ::Script::Attributes::Scope, AZ::Script::Attributes::ScopeFlags::Common)
                 ->Event("RegisterAction", &EnhancedInputRequests::RegisterAction)
                 ->Event("UnregisterAction", &EnhancedInputRequests::UnregisterAction)
-                ->Event("GetActionState", &EnhancedInputRequests::GetActionState);
+                ->Event("GetActionHandle", &EnhancedInputRequests::GetActionHandle)
+                ->Event("SetActionConsumesInput", &EnhancedInputRequests::SetActionConsumesInput)
+                ->Event("BeginContextChanges", &EnhancedInputRequests::BeginContextChanges)
+                ->Event("CommitContextChanges", &EnhancedInputRequests::CommitContextChanges)
+                ->Event("GetActionState", static_cast<const InputActionInstance* (EnhancedInputRequests::*)(const AZStd::string&) const>(&EnhancedInputRequests::GetActionState))
+                ->Event("GetActionStateByHandle", static_cast<const InputActionInstance* (EnhancedInputRequests::*)(ActionHandle) const>(&EnhancedInputRequests::GetActionState))
+                ->Event("GetLateLatchedActionValue", &EnhancedInputRequests::GetLateLatchedActionValue)
+                ->Event("GetFixedStepCount", static_cast<AZ::u32 (EnhancedInputRequests::*)() const>(&EnhancedInputRequests::GetFixedStepCount))
+                ->Event("GetFixedStepActionValue", static_cast<InputValue (EnhancedInputRequests::*)(ActionHandle, AZ::u32) const>(&EnhancedInputRequests::GetFixedStepActionValue))
+                ->Event("GetLocalUserFixedStepCount", static_cast<AZ::u32 (EnhancedInputRequests::*)(AzFramework::LocalUserId) const>(&EnhancedInputRequests::GetFixedStepCount))
+                ->Event("GetLocalUserFixedStepActionValue", static_cast<InputValue (EnhancedInputRequests::*)(AzFramework::LocalUserId, ActionHandle, AZ::u32) const>(&EnhancedInputRequests::GetFixedStepActionValue))
+                ->Event("SetActionHistoryCapacity", &EnhancedInputRequests::SetActionHistoryCapacity)
+                ->Event("WasTriggeredWithin", static_cast<bool (EnhancedInputRequests::*)(ActionHandle, float) const>(&EnhancedInputRequests::WasTriggeredWithin))
+                ->Event("TimeSinceLastState", static_cast<float (EnhancedInputRequests::*)(ActionHandle, TriggerState) const>(&EnhancedInputRequests::TimeSinceLastState))
+                ->Event("ConsumeBuffered", static_cast<bool (EnhancedInputRequests::*)(ActionHandle, float)>(&EnhancedInputRequests::ConsumeBuffered))
+                ->Event("LocalUserWasTriggeredWithin", static_cast<bool (EnhancedInputRequests::*)(AzFramework::LocalUserId, ActionHandle, float) const>(&EnhancedInputRequests::WasTriggeredWithin))
+                ->Event("LocalUserTimeSinceLastState", static_cast<float (EnhancedInputRequests::*)(AzFramework::LocalUserId, ActionHandle, TriggerState) const>(&EnhancedInputRequests::TimeSinceLastState))
+                ->Event("LocalUserConsumeBuffered", static_cast<bool (EnhancedInputRequests::*)(AzFramework::LocalUserId, ActionHandle, float)>(&EnhancedInputRequests::ConsumeBuffered))
+                ->Event("RegisterCombo", &EnhancedInputRequests::RegisterCombo)
+                ->Event("AddLocalUser", &EnhancedInputRequests::AddLocalUser)
+                ->Event("RemoveLocalUser", &EnhancedInputRequests::RemoveLocalUser)
+                ->Event("GetLocalUserActionState", &EnhancedInputRequests::GetLocalUserActionState)
+                ->Event("SetVirtualControllerCount", &EnhancedInputRequests::SetVirtualControllerCount)
+                ->Event("EvaluateVirtualControllers", &EnhancedInputRequests::EvaluateVirtualControllers)
+                ->Event("GetVirtualActionValue", &EnhancedInputRequests::GetVirtualActionValue)
+                ->Event("GetVirtualActionState", &EnhancedInputRequests::GetVirtualActionState)
+                ->Event("AddRemoteClient", &EnhancedInputRequests::AddRemoteClient)
+                ->Event("RemoveRemoteClient", &EnhancedInputRequests::RemoveRemoteClient)
+                ->Event("EvaluateRemoteFrames", &EnhancedInputRequests::EvaluateRemoteFrames)
+                ->Event("GetRemoteClientActionState", &EnhancedInputRequests::GetRemoteClientActionState)
+                ->Event("StartInputRecording", &EnhancedInputRequests::StartInputRecording)
+                ->Event("StopInputRecording", &EnhancedInputRequests::StopInputRecording)
+                ->Event("StartInputReplay", &EnhancedInputRequests::StartInputReplay)
+                ->Event("StopInputReplay", &EnhancedInputRequests::StopInputReplay)
+                ->Event("IsReplayingInput", &EnhancedInputRequests::IsReplayingInput);
 
             behaviorContext->EBus<EnhancedInputNotificationBus>("EnhancedInputNotificationBus")
                 ->Attribute(AZ::Script::Attributes::Category, "EnhancedInput")
@@ -166,6 +272,8 @@ namespace EnhancedInput
 
     EnhancedInputSystemComponent::EnhancedInputSystemComponent()
     {
+        ResetPipelines();
+
         if (EnhancedInputInterface::Get() == nullptr)
         {
             EnhancedInputInterface::Register(this);
@@ -189,6 +297,11 @@ namespace EnhancedInput
         EnhancedInputRequestBus::Handler::BusConnect();
         AZ::TickBus::Handler::BusConnect();
         AzFramework::InputChannelEventListener::Connect();
+
+        if (m_useSamplingThread)
+        {
+            StartSamplingThread();
+        }
     }
 
     void EnhancedInputSystemComponent::Deactivate()
@@ -197,285 +310,2218 @@ namespace EnhancedInput
         AZ::TickBus::Handler::BusDisconnect();
         EnhancedInputRequestBus::Handler::BusDisconnect();
 
+        StopSamplingThread();
+        StopInputRecording();
+        StopInputReplay();
+        m_sampledEvents.Clear();
+        m_sampledStates.Clear();
+        m_unsentSampledStates.clear();
+
         m_registeredActions.clear();
-        m_activeContexts.clear();
         m_actionBindings.clear();
-        m_actionStates.clear();
-        m_pendingInputs.clear();
+        m_freeActionHandles.clear();
+        m_actionHandles.clear();
+        m_pendingActionBindings.clear();
+        m_activeContexts.clear();
+        m_pendingContextChanges.clear();
+        m_contextChangeDepth = 0;
+        m_channelIndices.Clear();
+        ResetPipelines();
+        m_parallelPipelines.clear();
+        m_remoteClients.clear();
+        m_remoteClientIndices.clear();
+
+        m_channelDispatch.clear();
+        m_channelEntries.clear();
+        m_actionDispatch.clear();
+        m_actionEntries.clear();
+        m_compiledRevisions.clear();
+        m_compiledBindings.clear();
+        m_triggerSlotCount = 0;
+        m_compiledTriggers.clear();
+        m_modifierOps.clear();
+        m_dispatchDirty = true;
+
+        m_comboDefinitions.clear();
+        m_comboAutomaton.Clear();
+        m_combosDirty = false;
+
+        m_virtualControllers = VirtualControllerBatch();
     }
 
-    void EnhancedInputSystemComponent::RegisterAction(const AZStd::string& name, InputValueType valueType)
+    ActionHandle EnhancedInputSystemComponent::RegisterAction(const AZStd::string& name, InputValueType valueType)
     {
-        if (m_registeredActions.find(name) == m_registeredActions.end())
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+
+        auto handleIt = m_actionHandles.find(name);
+        if (handleIt != m_actionHandles.end())
+        {
+            return handleIt->second;
+        }
+
+        ActionHandle handle = InvalidActionHandle;
+        if (!m_freeActionHandles.empty())
+        {
+            handle = m_freeActionHandles.back();
+            m_freeActionHandles.pop_back();
+            m_registeredActions[handle] = InputAction(name, valueType);
+        }
+        else
+        {
+            handle = static_cast<ActionHandle>(m_registeredActions.size());
+            m_registeredActions.emplace_back(name, valueType);
+            m_actionBindings.emplace_back();
+        }
+
+        ForEachPipeline(
+            [this, handle](InputPipeline& pipeline)
+            {
+                SizePipeline(pipeline);
+                pipeline.m_actionHistories[handle].SetCapacity(m_defaultHistoryCapacity);
+                pipeline.m_actionStates.ResetSlot(handle);
+                pipeline.m_actionStates.m_registered[handle] = 1;
+            });
+
+        auto pendingIt = m_pendingActionBindings.find(name);
+        if (pendingIt != m_pendingActionBindings.end())
+        {
+            m_actionBindings[handle] = AZStd::move(pendingIt->second);
+            m_pendingActionBindings.erase(pendingIt);
+        }
+        else
         {
-            m_registeredActions[name] = InputAction(name, valueType);
-            m_actionStates[name] = ActionRuntimeState();
-            m_actionStates[name].m_instance.m_action = &m_registeredActions[name];
+            m_actionBindings[handle] = ActionBindingData();
         }
+
+        m_actionHandles[name] = handle;
+        m_dispatchDirty = true;
+        m_combosDirty = m_combosDirty || IsComboAction(name);
+        return handle;
     }
 
     void EnhancedInputSystemComponent::UnregisterAction(const AZStd::string& name)
     {
-        m_registeredActions.erase(name);
-        m_actionStates.erase(name);
-        m_actionBindings.erase(name);
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+
+        auto handleIt = m_actionHandles.find(name);
+        if (handleIt == m_actionHandles.end())
+        {
+            m_pendingActionBindings.erase(name);
+            return;
+        }
+
+        const ActionHandle handle = handleIt->second;
+        m_actionHandles.erase(handleIt);
+
+        m_registeredActions[handle] = InputAction();
+        ForEachPipeline(
+            [handle](InputPipeline& pipeline)
+            {
+                pipeline.m_actionStates.ResetSlot(handle);
+            });
+        m_actionBindings[handle] = ActionBindingData();
+
+        VirtualControllerBatch& batch = m_virtualControllers;
+        const size_t actionColumn = static_cast<size_t>(handle) * batch.m_controllerCount;
+        if (actionColumn + batch.m_controllerCount <= batch.m_actionValues.size())
+        {
+            AZStd::fill_n(batch.m_injectedActionValues.begin() + actionColumn, batch.m_controllerCount, InputValue());
+            AZStd::fill_n(batch.m_actionValues.begin() + actionColumn, batch.m_controllerCount, InputValue());
+            AZStd::fill_n(batch.m_triggerStates.begin() + actionColumn, batch.m_controllerCount, TriggerState::None);
+            AZStd::fill_n(batch.m_elapsedTimes.begin() + actionColumn, batch.m_controllerCount, 0.0f);
+        }
+        m_freeActionHandles.push_back(handle);
+        m_dispatchDirty = true;
+        m_combosDirty = m_combosDirty || IsComboAction(name);
+
+        for (auto comboIt = m_comboDefinitions.begin(); comboIt != m_comboDefinitions.end(); ++comboIt)
+        {
+            if (comboIt->m_name == name)
+            {
+                m_comboDefinitions.erase(comboIt);
+                break;
+            }
+        }
+    }
+
+    bool EnhancedInputSystemComponent::IsComboAction(const AZStd::string& name) const
+    {
+        for (const ComboDefinition& definition : m_comboDefinitions)
+        {
+            if (definition.m_name == name || AZStd::find(definition.m_steps.begin(), definition.m_steps.end(), name) != definition.m_steps.end())
+            {
+                return true;
+            }
+        }
+        return false;
     }
 
     const InputAction* EnhancedInputSystemComponent::GetAction(const AZStd::string& name) const
     {
-        auto it = m_registeredActions.find(name);
-        return it != m_registeredActions.end() ? &it->second : nullptr;
+        const ActionHandle handle = GetActionHandle(name);
+        return handle != InvalidActionHandle ? &m_registeredActions[handle] : nullptr;
+    }
+
+    ActionHandle EnhancedInputSystemComponent::GetActionHandle(const AZStd::string& name) const
+    {
+        auto it = m_actionHandles.find(name);
+        return it != m_actionHandles.end() ? it->second : InvalidActionHandle;
+    }
+
+    void EnhancedInputSystemComponent::SetActionConsumesInput(ActionHandle action, bool consume)
+    {
+        if (IsRegistered(action) && m_registeredActions[action].GetConsumeInput() != consume)
+        {
+            AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+            m_registeredActions[action].SetConsumeInput(consume);
+            m_dispatchDirty = true;
+        }
     }
 
     void EnhancedInputSystemComponent::AddMappingContext(InputMappingContextPtr context, int priority)
     {
         if (context)
         {
-            ActiveMappingContext active;
-            active.m_context = context;
-            active.m_priority = priority;
-            m_activeContexts.insert(active);
+            ContextChange change;
+            change.m_type = ContextChangeType::Add;
+            change.m_context.m_context = AZStd::move(context);
+            change.m_context.m_priority = priority;
+            m_pendingContextChanges.push_back(AZStd::move(change));
         }
     }
 
     void EnhancedInputSystemComponent::RemoveMappingContext(const AZStd::string& contextName)
     {
-        for (auto it = m_activeContexts.begin(); it != m_activeContexts.end(); ++it)
-        {
-            if (it->m_context && it->m_context->GetName() == contextName)
-            {
-                m_activeContexts.erase(it);
-                break;
-            }
-        }
+        ContextChange change;
+        change.m_type = ContextChangeType::Remove;
+        change.m_contextName = contextName;
+        m_pendingContextChanges.push_back(AZStd::move(change));
     }
 
     void EnhancedInputSystemComponent::ClearMappingContexts()
     {
-        m_activeContexts.clear();
+        ContextChange change;
+        change.m_type = ContextChangeType::Clear;
+        m_pendingContextChanges.push_back(AZStd::move(change));
+    }
+
+    void EnhancedInputSystemComponent::BeginContextChanges()
+    {
+        ++m_contextChangeDepth;
+    }
+
+    void EnhancedInputSystemComponent::CommitContextChanges()
+    {
+        AZ_Warning("EnhancedInput", m_contextChangeDepth > 0, "CommitContextChanges called without a matching BeginContextChanges.");
+        if (m_contextChangeDepth > 0)
+        {
+            --m_contextChangeDepth;
+        }
     }
 
     void EnhancedInputSystemComponent::BindAction(const AZStd::string& actionName, TriggerEvent events, InputActionCallback callback)
     {
-        m_actionBindings[actionName] = ActionBindingData{ events, callback };
+        const ActionHandle handle = GetActionHandle(actionName);
+        if (handle == InvalidActionHandle)
+        {
+            m_pendingActionBindings[actionName] = ActionBindingData{ events, AZStd::move(callback) };
+            return;
+        }
+
+        BindAction(handle, events, AZStd::move(callback));
+    }
+
+    void EnhancedInputSystemComponent::BindAction(ActionHandle action, TriggerEvent events, InputActionCallback callback)
+    {
+        if (IsRegistered(action))
+        {
+            m_actionBindings[action] = ActionBindingData{ events, AZStd::move(callback) };
+        }
     }
 
     void EnhancedInputSystemComponent::UnbindAction(const AZStd::string& actionName)
     {
-        m_actionBindings.erase(actionName);
+        const ActionHandle handle = GetActionHandle(actionName);
+        if (handle == InvalidActionHandle)
+        {
+            m_pendingActionBindings.erase(actionName);
+            return;
+        }
+
+        m_actionBindings[handle] = ActionBindingData();
     }
 
     const InputActionInstance* EnhancedInputSystemComponent::GetActionState(const AZStd::string& actionName) const
     {
-        auto it = m_actionStates.find(actionName);
-        return it != m_actionStates.end() ? &it->second.m_instance : nullptr;
+        return GetActionState(GetActionHandle(actionName));
     }
 
-    bool EnhancedInputSystemComponent::OnInputChannelEventFiltered(const AzFramework::InputChannel& inputChannel)
+    const InputActionInstance* EnhancedInputSystemComponent::GetActionState(ActionHandle action) const
     {
-        const AzFramework::InputChannelId& channelId = inputChannel.GetInputChannelId();
-        AZ::Crc32 channelCrc = channelId.GetNameCrc32();
-        float value = inputChannel.GetValue();
+        return GetActionState(GetDefaultPipeline(), action);
+    }
 
-        if (inputChannel.IsStateEnded())
-        {
-            m_pendingInputs[channelCrc] = InputValue(0.0f);
-        }
-        else
+    const InputActionInstance* EnhancedInputSystemComponent::GetActionState(const InputPipeline& pipeline, ActionHandle action) const
+    {
+        if (!IsRegistered(action))
         {
-            m_pendingInputs[channelCrc] = InputValue(value);
+            return nullptr;
         }
 
-        return false;
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        InputActionInstance& instance = pipeline.m_actionInstances[action];
+        pipeline.m_actionStates.BuildInstance(action, &m_registeredActions[action], instance);
+        instance.m_localUserId = pipeline.m_localUserId;
+        return &instance;
     }
 
-    void EnhancedInputSystemComponent::OnTick(float deltaTime, [[maybe_unused]] AZ::ScriptTimePoint time)
+    void EnhancedInputSystemComponent::SetActionHistoryCapacity(ActionHandle action, AZ::u32 capacity)
     {
-        for (auto& [actionName, state] : m_actionStates)
+        if (IsRegistered(action))
         {
-            state.m_accumulatedValue = InputValue();
+            AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+            ForEachPipeline(
+                [action, capacity](InputPipeline& pipeline)
+                {
+                    pipeline.m_actionHistories[action].SetCapacity(capacity);
+                });
         }
+    }
 
-        for (const auto& activeContext : m_activeContexts)
-        {
-            if (!activeContext.m_context)
-            {
-                continue;
-            }
+    bool EnhancedInputSystemComponent::WasTriggeredWithin(ActionHandle action, float seconds) const
+    {
+        const float timeSinceTriggered = TimeSinceLastState(action, TriggerState::Triggered);
+        return timeSinceTriggered >= 0.0f && timeSinceTriggered <= seconds;
+    }
 
-            for (const auto& binding : activeContext.m_context->GetBindings())
-            {
-                auto inputIt = m_pendingInputs.find(binding.m_inputChannelId.GetNameCrc32());
-                if (inputIt == m_pendingInputs.end())
-                {
-                    continue;
-                }
+    float EnhancedInputSystemComponent::TimeSinceLastState(ActionHandle action, TriggerState state) const
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        return TimeSinceLastState(GetDefaultPipeline(), action, state);
+    }
+
+    bool EnhancedInputSystemComponent::ConsumeBuffered(ActionHandle action, float seconds)
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        return ConsumeBuffered(GetDefaultPipeline(), action, seconds);
+    }
 
-                InputValue modifiedValue = ApplyModifiers(inputIt->second, binding.m_modifiers);
+    bool EnhancedInputSystemComponent::WasTriggeredWithin(AzFramework::LocalUserId localUserId, ActionHandle action, float seconds) const
+    {
+        const float timeSinceTriggered = TimeSinceLastState(localUserId, action, TriggerState::Triggered);
+        return timeSinceTriggered >= 0.0f && timeSinceTriggered <= seconds;
+    }
 
-                auto stateIt = m_actionStates.find(binding.m_actionName);
-                if (stateIt != m_actionStates.end())
-                {
-                    AZ::Vector3 current = stateIt->second.m_accumulatedValue.GetAxis3D();
-                    AZ::Vector3 incoming = modifiedValue.GetAxis3D();
-                    stateIt->second.m_accumulatedValue = InputValue(current + incoming);
+    float EnhancedInputSystemComponent::TimeSinceLastState(AzFramework::LocalUserId localUserId, ActionHandle action, TriggerState state) const
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        const InputPipeline* pipeline = FindPipeline(localUserId);
+        return pipeline ? TimeSinceLastState(*pipeline, action, state) : -1.0f;
+    }
 
-                    for (const auto& trigger : binding.m_triggers)
-                    {
-                        if (trigger)
-                        {
-                            stateIt->second.m_activeTriggers.push_back(trigger);
-                        }
-                    }
-                }
-            }
-        }
+    bool EnhancedInputSystemComponent::ConsumeBuffered(AzFramework::LocalUserId localUserId, ActionHandle action, float seconds)
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        InputPipeline* pipeline = FindPipeline(localUserId);
+        return pipeline ? ConsumeBuffered(*pipeline, action, seconds) : false;
+    }
 
-        for (auto& [actionName, state] : m_actionStates)
+    float EnhancedInputSystemComponent::TimeSinceLastState(const InputPipeline& pipeline, ActionHandle action, TriggerState state) const
+    {
+        if (!IsRegistered(action))
         {
-            state.m_instance.m_previousValue = state.m_instance.m_value;
-            state.m_instance.m_value = state.m_accumulatedValue;
+            return -1.0f;
+        }
 
-            TriggerState triggerState = TriggerState::None;
+        const AZStd::sys_time_t stateTimeUs = pipeline.m_actionHistories[action].GetLastStateTime(state);
+        if (stateTimeUs == 0)
+        {
+            return -1.0f;
+        }
+        return static_cast<float>(pipeline.m_lastTickTimeUs - stateTimeUs) / 1000000.0f;
+    }
 
-            if (!state.m_activeTriggers.empty())
-            {
-                triggerState = EvaluateTriggers(state.m_accumulatedValue, state.m_activeTriggers, deltaTime);
-                state.m_activeTriggers.clear();
-            }
-            else
-            {
-                if (!state.m_accumulatedValue.IsZero())
-                {
-                    triggerState = TriggerState::Triggered;
-                }
-            }
+    bool EnhancedInputSystemComponent::ConsumeBuffered(InputPipeline& pipeline, ActionHandle action, float seconds)
+    {
+        if (!IsRegistered(action))
+        {
+            return false;
+        }
 
-            TriggerState previousState = state.m_instance.m_triggerState;
-            state.m_instance.m_triggerState = triggerState;
+        const AZStd::sys_time_t sinceUs = pipeline.m_lastTickTimeUs - static_cast<AZStd::sys_time_t>(seconds * 1000000.0f);
+        return pipeline.m_actionHistories[action].ConsumeTriggered(sinceUs);
+    }
 
-            if (triggerState != TriggerState::None || previousState != TriggerState::None)
-            {
-                state.m_instance.m_elapsedTime += deltaTime;
-                if (triggerState == TriggerState::Triggered)
-                {
-                    state.m_instance.m_triggeredTime = state.m_instance.m_elapsedTime;
-                }
+    ActionHandle EnhancedInputSystemComponent::RegisterCombo(
+        const AZStd::string& comboName, const AZStd::vector<AZStd::string>& sequence, float maxStepInterval)
+    {
+        if (sequence.empty())
+        {
+            AZ_Warning("EnhancedInput", false, "Combo '%s' has no steps.", comboName.c_str());
+            return InvalidActionHandle;
+        }
 
-                NotifyActionState(actionName, state.m_instance);
-            }
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        const ActionHandle handle = RegisterAction(comboName, InputValueType::Boolean);
 
-            if (triggerState == TriggerState::None || triggerState == TriggerState::Completed || triggerState == TriggerState::Canceled)
+        ComboDefinition* definition = nullptr;
+        for (ComboDefinition& existing : m_comboDefinitions)
+        {
+            if (existing.m_name == comboName)
             {
-                state.m_instance.m_elapsedTime = 0.0f;
+                definition = &existing;
+                break;
             }
         }
+        if (!definition)
+        {
+            definition = &m_comboDefinitions.emplace_back();
+            definition->m_name = comboName;
+        }
 
-        m_pendingInputs.clear();
+        definition->m_steps = sequence;
+        definition->m_maxStepInterval = maxStepInterval;
+        m_combosDirty = true;
+        return handle;
     }
 
-    void EnhancedInputSystemComponent::ProcessInputForAction(
-        [[maybe_unused]] const AZStd::string& actionName,
-        [[maybe_unused]] const InputValue& rawValue,
-        [[maybe_unused]] float deltaTime)
+    void EnhancedInputSystemComponent::AddLocalUser(AzFramework::LocalUserId localUserId)
     {
+        if (localUserId == AzFramework::LocalUserIdAny || localUserId == AzFramework::LocalUserIdNone)
+        {
+            AZ_Warning("EnhancedInput", false, "AddLocalUser needs a specific local user id.");
+            return;
+        }
+
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        if (FindPipeline(localUserId))
+        {
+            return;
+        }
+
+        auto pipeline = AZStd::make_unique<InputPipeline>();
+        pipeline->m_localUserId = localUserId;
+        SizePipeline(*pipeline);
+        const ActionStateStorage& defaultStates = GetDefaultPipeline().m_actionStates;
+        for (ActionHandle handle = 0; handle < defaultStates.GetSize(); ++handle)
+        {
+            pipeline->m_actionHistories[handle].SetCapacity(m_defaultHistoryCapacity);
+            pipeline->m_actionStates.m_registered[handle] = defaultStates.m_registered[handle];
+        }
+        m_pipelines.push_back(AZStd::move(pipeline));
     }
 
-    void EnhancedInputSystemComponent::NotifyActionState(const AZStd::string& actionName, const InputActionInstance& instance)
+    void EnhancedInputSystemComponent::RemoveLocalUser(AzFramework::LocalUserId localUserId)
     {
-        auto bindingIt = m_actionBindings.find(actionName);
-        if (bindingIt != m_actionBindings.end())
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        InputPipeline* pipeline = FindPipeline(localUserId);
+        if (pipeline && pipeline != &GetDefaultPipeline())
         {
-            const auto& binding = bindingIt->second;
-            bool shouldCallback = false;
+            // Left in place, so a tick iterating the pipelines from a callback neither skips nor revisits one.
+            pipeline->m_isRetired = true;
+        }
+    }
 
-            switch (instance.m_triggerState)
-            {
-            case TriggerState::Started:
-                shouldCallback = HasFlag(binding.m_events, TriggerEvent::Started);
-                break;
-            case TriggerState::Ongoing:
-                shouldCallback = HasFlag(binding.m_events, TriggerEvent::Ongoing);
-                break;
-            case TriggerState::Triggered:
-                shouldCallback = HasFlag(binding.m_events, TriggerEvent::Triggered);
-                break;
-            case TriggerState::Completed:
-                shouldCallback = HasFlag(binding.m_events, TriggerEvent::Completed);
-                break;
-            case TriggerState::Canceled:
-                shouldCallback = HasFlag(binding.m_events, TriggerEvent::Canceled);
-                break;
-            default:
-                break;
-            }
+    void EnhancedInputSystemComponent::DestroyRetiredPipelines()
+    {
+        m_pipelines.erase(
+            AZStd::remove_if(m_pipelines.begin(), m_pipelines.end(),
+                [](const AZStd::unique_ptr<InputPipeline>& pipeline)
+                {
+                    return pipeline->m_isRetired;
+                }),
+            m_pipelines.end());
+    }
 
-            if (shouldCallback && binding.m_callback)
-            {
-                binding.m_callback(instance);
-            }
+    const InputActionInstance* EnhancedInputSystemComponent::GetLocalUserActionState(AzFramework::LocalUserId localUserId, ActionHandle action) const
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        const InputPipeline* pipeline = FindPipeline(localUserId);
+        return pipeline ? GetActionState(*pipeline, action) : nullptr;
+    }
+
+    void EnhancedInputSystemComponent::AddRemoteClient(AZ::u32 clientId)
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        if (m_remoteClientIndices.find(clientId) != m_remoteClientIndices.end())
+        {
+            return;
         }
 
-        switch (instance.m_triggerState)
+        auto pipeline = AZStd::make_unique<InputPipeline>();
+        pipeline->m_isRemote = true;
+        // A remote client's clock starts at its first frame; zero would mean no frame was evaluated yet.
+        pipeline->m_lastTickTimeUs = 1;
+        SizePipeline(*pipeline);
+        const ActionStateStorage& defaultStates = GetDefaultPipeline().m_actionStates;
+        for (ActionHandle handle = 0; handle < defaultStates.GetSize(); ++handle)
         {
-        case TriggerState::Started:
-            EnhancedInputNotificationBus::Broadcast(&EnhancedInputNotifications::OnActionStarted, instance);
-            break;
-        case TriggerState::Ongoing:
-            EnhancedInputNotificationBus::Broadcast(&EnhancedInputNotifications::OnActionOngoing, instance);
-            break;
-        case TriggerState::Triggered:
-            EnhancedInputNotificationBus::Broadcast(&EnhancedInputNotifications::OnActionTriggered, instance);
-            break;
-        case TriggerState::Completed:
-            EnhancedInputNotificationBus::Broadcast(&EnhancedInputNotifications::OnActionCompleted, instance);
-            break;
-        case TriggerState::Canceled:
-            EnhancedInputNotificationBus::Broadcast(&EnhancedInputNotifications::OnActionCanceled, instance);
-            break;
-        default:
-            break;
+            pipeline->m_actionHistories[handle].SetCapacity(m_defaultHistoryCapacity);
+            pipeline->m_actionStates.m_registered[handle] = defaultStates.m_registered[handle];
         }
+        m_remoteClientIndices[clientId] = m_remoteClients.size();
+        m_remoteClients.push_back(AZStd::move(pipeline));
     }
 
-    InputValue EnhancedInputSystemComponent::ApplyModifiers(const InputValue& value, const AZStd::vector<InputModifierPtr>& modifiers) const
+    void EnhancedInputSystemComponent::RemoveRemoteClient(AZ::u32 clientId)
     {
-        InputValue result = value;
-        for (const auto& modifier : modifiers)
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        auto indexIt = m_remoteClientIndices.find(clientId);
+        if (indexIt == m_remoteClientIndices.end())
+        {
+            return;
+        }
+
+        const size_t index = indexIt->second;
+        m_remoteClientIndices.erase(indexIt);
+        if (index != m_remoteClients.size() - 1)
         {
-            if (modifier)
+            m_remoteClients[index] = AZStd::move(m_remoteClients.back());
+            for (auto& entry : m_remoteClientIndices)
             {
-                result = modifier->ModifyValue(result);
+                if (entry.second == m_remoteClients.size() - 1)
+                {
+                    entry.second = index;
+                    break;
+                }
             }
         }
-        return result;
+        m_remoteClients.pop_back();
     }
 
-    TriggerState EnhancedInputSystemComponent::EvaluateTriggers(
-        const InputValue& value,
-        AZStd::vector<InputTriggerPtr>& triggers,
-        float deltaTime) const
+    void EnhancedInputSystemComponent::EvaluateRemoteFrames(
+        const AZStd::vector<RemoteInputFrame>& frames, const AZStd::vector<RemoteInputEvent>& events)
     {
-        if (triggers.empty())
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        UpdateCompiledData();
+
+        for (const RemoteInputFrame& frame : frames)
         {
-            return value.IsZero() ? TriggerState::None : TriggerState::Triggered;
-        }
+            auto indexIt = m_remoteClientIndices.find(frame.m_clientId);
+            if (indexIt == m_remoteClientIndices.end())
+            {
+                continue;
+            }
 
-        TriggerState bestState = TriggerState::None;
+            if (frame.m_firstEvent + frame.m_eventCount > events.size())
+            {
+                AZ_Warning("EnhancedInput", false, "Remote frame of client %u references events past the end of the batch.", frame.m_clientId);
+                continue;
+            }
 
-        for (auto& trigger : triggers)
-        {
-            if (trigger)
+            InputPipeline& pipeline = *m_remoteClients[indexIt->second];
+            const AZStd::sys_time_t frameStartUs = pipeline.m_lastTickTimeUs;
+            const AZStd::sys_time_t frameEndUs = frameStartUs + static_cast<AZStd::sys_time_t>(frame.m_deltaTime * 1000000.0f);
+
+            for (AZ::u32 eventIndex = frame.m_firstEvent; eventIndex < frame.m_firstEvent + frame.m_eventCount; ++eventIndex)
             {
-                TriggerState state = trigger->UpdateState(value, deltaTime);
-                if (static_cast<int>(state) > static_cast<int>(bestState))
+                const RemoteInputEvent& remoteEvent = events[eventIndex];
+                const ChannelIndex channel = m_channelIndices.FindChannel(AZ::Crc32(remoteEvent.m_channelCrc));
+                if (channel == InvalidChannelIndex)
                 {
-                    bestState = state;
+                    continue;
                 }
+
+                InputEvent event;
+                event.m_timeUs = AZ::GetMin(frameStartUs + remoteEvent.m_timeOffsetUs, frameEndUs);
+                event.m_channel = channel;
+                event.m_value = remoteEvent.m_value;
+                QueueInputEvent(pipeline, event);
             }
+
+            EvaluateActions(pipeline, frame.m_deltaTime, frameEndUs);
         }
+    }
+
+    const InputActionInstance* EnhancedInputSystemComponent::GetRemoteClientActionState(AZ::u32 clientId, ActionHandle action) const
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        auto indexIt = m_remoteClientIndices.find(clientId);
+        return indexIt != m_remoteClientIndices.end() ? GetActionState(*m_remoteClients[indexIt->second], action) : nullptr;
+    }
 
-        return bestState;
+    void EnhancedInputSystemComponent::GetActionValueTypes(AZStd::vector<InputValueType>& valueTypes) const
+    {
+        valueTypes.clear();
+        valueTypes.reserve(m_registeredActions.size());
+        for (const InputAction& action : m_registeredActions)
+        {
+            valueTypes.push_back(action.GetValueType());
+        }
+    }
+
+    void EnhancedInputSystemComponent::CopyActionStates(
+        AzFramework::LocalUserId localUserId, AZStd::vector<InputValue>& values, AZStd::vector<TriggerState>& triggerStates) const
+    {
+        values.clear();
+        triggerStates.clear();
+
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        if (const InputPipeline* pipeline = FindPipeline(localUserId))
+        {
+            const ActionStateStorage& states = pipeline->m_actionStates;
+            values.assign(states.m_values.begin(), states.m_values.end());
+            triggerStates.assign(states.m_triggerStates.begin(), states.m_triggerStates.end());
+        }
+    }
+
+    void EnhancedInputSystemComponent::SaveState(AzFramework::LocalUserId localUserId, AZStd::vector<AZ::u8>& state) const
+    {
+        state.clear();
+
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        const InputPipeline* pipeline = FindPipeline(localUserId);
+        if (!pipeline)
+        {
+            return;
+        }
+
+        StateBlobWriter writer(state);
+        writer.Write(GetPipelineStateLayout(*pipeline));
+        writer.Write(pipeline->m_lastTickTimeUs);
+        writer.Write(pipeline->m_evaluationTimeUs);
+        writer.Write(pipeline->m_fixedStepAccumulator);
+        pipeline->m_actionStates.SaveState(writer);
+        pipeline->m_channelStates.SaveState(writer);
+        writer.WriteArray(pipeline->m_triggerStates);
+        for (const ActionHistory& history : pipeline->m_actionHistories)
+        {
+            history.SaveState(writer);
+        }
+
+        const ComboMatchState& comboState = pipeline->m_comboMatchState;
+        writer.Write(comboState.m_node);
+        writer.Write(comboState.m_activationHead);
+        writer.Write(comboState.m_activationCount);
+        writer.WriteArray(comboState.m_activationTimes);
+    }
+
+    bool EnhancedInputSystemComponent::RestoreState(AzFramework::LocalUserId localUserId, const AZStd::vector<AZ::u8>& state)
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        InputPipeline* pipeline = FindPipeline(localUserId);
+        if (!pipeline)
+        {
+            return false;
+        }
+
+        StateBlobReader reader(state.data(), state.size());
+        PipelineStateLayout layout;
+        if (!reader.Read(layout) || !(layout == GetPipelineStateLayout(*pipeline)))
+        {
+            AZ_Warning("EnhancedInput", false, "Input state was saved from a pipeline of a different shape and cannot be restored.");
+            return false;
+        }
+
+        ComboMatchState& comboState = pipeline->m_comboMatchState;
+        bool isRestored = reader.Read(pipeline->m_lastTickTimeUs) && reader.Read(pipeline->m_evaluationTimeUs) &&
+            reader.Read(pipeline->m_fixedStepAccumulator) && pipeline->m_actionStates.RestoreState(reader) &&
+            pipeline->m_channelStates.RestoreState(reader) && reader.ReadArray(pipeline->m_triggerStates);
+        for (ActionHistory& history : pipeline->m_actionHistories)
+        {
+            isRestored = isRestored && history.RestoreState(reader);
+        }
+        isRestored = isRestored && reader.Read(comboState.m_node) && reader.Read(comboState.m_activationHead) &&
+            reader.Read(comboState.m_activationCount) && reader.ReadArray(comboState.m_activationTimes) && reader.IsAtEnd();
+        AZ_Error("EnhancedInput", isRestored, "Input state is truncated or corrupt; the pipeline was only partially restored.");
+
+        // Events queued for the abandoned timeline are dropped, and every action is re-evaluated on the next tick,
+        // since which actions were dirty is not part of the saved state.
+        pipeline->m_inputEvents.Clear();
+        for (ActionHandle handle = 0; handle < pipeline->m_actionStates.GetSize(); ++handle)
+        {
+            MarkActionDirty(*pipeline, handle);
+        }
+        return isRestored;
+    }
+
+    InputPipeline* EnhancedInputSystemComponent::FindPipeline(AzFramework::LocalUserId localUserId) const
+    {
+        for (const auto& pipeline : m_pipelines)
+        {
+            if (pipeline->m_localUserId == localUserId && !pipeline->m_isRetired)
+            {
+                return pipeline.get();
+            }
+        }
+        return nullptr;
+    }
+
+    InputPipeline& EnhancedInputSystemComponent::RoutePipeline(AzFramework::LocalUserId localUserId) const
+    {
+        InputPipeline* pipeline = FindPipeline(localUserId);
+        return pipeline ? *pipeline : GetDefaultPipeline();
+    }
+
+    void EnhancedInputSystemComponent::ResetPipelines()
+    {
+        m_pipelines.clear();
+        m_pipelines.push_back(AZStd::make_unique<InputPipeline>());
+    }
+
+    void EnhancedInputSystemComponent::SizePipeline(InputPipeline& pipeline) const
+    {
+        const size_t actionCount = m_registeredActions.size();
+        pipeline.m_actionStates.Resize(actionCount);
+        // A handle is queued at most once per tick, so this keeps MarkActionDirty allocation free. The ticking list is
+        // grown by EvaluateActions instead, since a callback may register an action while it is being iterated.
+        pipeline.m_dirtyActions.reserve(actionCount);
+        // Enough for one notification per action, the usual upper bound of a tick evaluated as a job.
+        pipeline.m_deferredNotifications.reserve(actionCount);
+        pipeline.m_actionHistories.resize(actionCount);
+        pipeline.m_actionInstances.resize(actionCount);
+
+        const ChannelIndex channelCount = m_channelIndices.GetChannelCount();
+        pipeline.m_channelStates.Resize(channelCount);
+        pipeline.m_replayedChannels.resize((channelCount + 63) / 64, 0);
+        pipeline.m_triggerStates.resize(m_triggerSlotCount);
+
+        pipeline.m_completedCombos.reserve(m_comboAutomaton.GetComboCount() * 2);
+        pipeline.m_firedCombos.reserve(m_comboAutomaton.GetComboCount());
+        pipeline.m_isComboFired.resize(actionCount, 0);
+        if (pipeline.m_comboMatchState.m_activationTimes.empty())
+        {
+            m_comboAutomaton.ResetState(pipeline.m_comboMatchState);
+        }
+    }
+
+    void EnhancedInputSystemComponent::SetVirtualControllerCount(AZ::u32 count)
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        m_virtualControllers = VirtualControllerBatch();
+        m_virtualControllers.m_controllerCount = count;
+        SizeVirtualControllers();
+    }
+
+    float* EnhancedInputSystemComponent::GetVirtualChannelValues(const AzFramework::InputChannelId& channelId)
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        const ChannelIndex channel = m_channelIndices.FindChannel(channelId.GetNameCrc32());
+        if (channel == InvalidChannelIndex || m_virtualControllers.m_controllerCount == 0)
+        {
+            return nullptr;
+        }
+
+        SizeVirtualControllers();
+        return m_virtualControllers.m_channelValues.data() + static_cast<size_t>(channel) * m_virtualControllers.m_controllerCount;
+    }
+
+    InputValue* EnhancedInputSystemComponent::GetVirtualActionValues(ActionHandle action)
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        if (!IsRegistered(action) || m_virtualControllers.m_controllerCount == 0)
+        {
+            return nullptr;
+        }
+
+        SizeVirtualControllers();
+        return m_virtualControllers.m_injectedActionValues.data() + static_cast<size_t>(action) * m_virtualControllers.m_controllerCount;
+    }
+
+    InputValue EnhancedInputSystemComponent::GetVirtualActionValue(AZ::u32 controller, ActionHandle action) const
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        const VirtualControllerBatch& batch = m_virtualControllers;
+        const size_t index = static_cast<size_t>(action) * batch.m_controllerCount + controller;
+        return controller < batch.m_controllerCount && index < batch.m_actionValues.size() ? batch.m_actionValues[index] : InputValue();
+    }
+
+    TriggerState EnhancedInputSystemComponent::GetVirtualActionState(AZ::u32 controller, ActionHandle action) const
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        const VirtualControllerBatch& batch = m_virtualControllers;
+        const size_t index = static_cast<size_t>(action) * batch.m_controllerCount + controller;
+        return controller < batch.m_controllerCount && index < batch.m_triggerStates.size() ? batch.m_triggerStates[index] : TriggerState::None;
+    }
+
+    void EnhancedInputSystemComponent::SizeVirtualControllers()
+    {
+        // Column-major, so new channels and actions append columns and existing values stay where they are.
+        VirtualControllerBatch& batch = m_virtualControllers;
+        const size_t controllerCount = batch.m_controllerCount;
+        const size_t channelValueCount = controllerCount * m_channelIndices.GetChannelCount();
+        const size_t actionValueCount = controllerCount * m_registeredActions.size();
+
+        batch.m_channelValues.resize(channelValueCount, 0.0f);
+        batch.m_previousChannelValues.resize(channelValueCount, 0.0f);
+        batch.m_injectedActionValues.resize(actionValueCount);
+        batch.m_actionValues.resize(actionValueCount);
+        batch.m_triggerStates.resize(actionValueCount, TriggerState::None);
+        batch.m_elapsedTimes.resize(actionValueCount, 0.0f);
+        batch.m_triggerRuntimeStates.resize(controllerCount * m_triggerSlotCount);
+
+        batch.m_accumulated.resize(controllerCount);
+        batch.m_evaluatedStates.resize(controllerCount);
+        batch.m_hasActiveTriggers.resize(controllerCount);
+        batch.m_triggerInputs.resize(controllerCount);
+        batch.m_isBindingActive.resize(controllerCount);
+        batch.m_triggerResults.resize(controllerCount);
+        batch.m_modifierLanesX.resize(GetPaddedLaneCount(controllerCount));
+        batch.m_modifierLanesY.resize(GetPaddedLaneCount(controllerCount));
+        batch.m_modifierLanesZ.resize(GetPaddedLaneCount(controllerCount));
+    }
+
+    void EnhancedInputSystemComponent::EvaluateVirtualControllers(float deltaTime)
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+
+        // A stale index no longer matches the contexts, whether they changed or bindings were edited in place;
+        // the game thread recompiles it on its next tick.
+        VirtualControllerBatch& batch = m_virtualControllers;
+        if (batch.m_controllerCount == 0 || m_dispatchDirty || IsDispatchIndexStale())
+        {
+            return;
+        }
+
+        SizeVirtualControllers();
+        AllocationTrackingScope allocationScope;
+
+        for (ActionHandle action = 0; action < m_registeredActions.size(); ++action)
+        {
+            if (IsRegistered(action))
+            {
+                EvaluateVirtualAction(action, deltaTime);
+            }
+        }
+
+        AZStd::copy(batch.m_channelValues.begin(), batch.m_channelValues.end(), batch.m_previousChannelValues.begin());
+
+        AZ_Error("EnhancedInput", !m_trackTickAllocations || allocationScope.GetAllocationCount() == 0,
+            "%u allocations by runtime containers while evaluating virtual controllers.", allocationScope.GetAllocationCount());
+    }
+
+    void EnhancedInputSystemComponent::EvaluateVirtualAction(ActionHandle action, float deltaTime)
+    {
+        // Same rules as UpdateAction, with the controller loop innermost so each binding's modifiers and triggers
+        // are resolved once and then applied across consecutive controller values.
+        VirtualControllerBatch& batch = m_virtualControllers;
+        const AZ::u32 controllerCount = batch.m_controllerCount;
+        const size_t actionColumn = static_cast<size_t>(action) * controllerCount;
+
+        AZ::Vector3* accumulated = batch.m_accumulated.data();
+        const InputValue* injected = batch.m_injectedActionValues.data() + actionColumn;
+        for (AZ::u32 controller = 0; controller < controllerCount; ++controller)
+        {
+            accumulated[controller] = injected[controller].GetAxis3D();
+        }
+
+        DispatchRange range;
+        if (action < m_actionDispatch.size())
+        {
+            range = m_actionDispatch[action];
+        }
+        const AZ::u32 rangeEnd = range.m_first + range.m_count;
+
+        for (AZ::u32 entryIndex = range.m_first; entryIndex < rangeEnd; ++entryIndex)
+        {
+            const DispatchEntry& entry = m_actionEntries[entryIndex];
+            const float* values = batch.m_channelValues.data() + static_cast<size_t>(entry.m_channel) * controllerCount;
+            float* lanesX = batch.m_modifierLanesX.data();
+            float* lanesY = batch.m_modifierLanesY.data();
+            float* lanesZ = batch.m_modifierLanesZ.data();
+            AZStd::copy(values, values + controllerCount, lanesX);
+            RunModifierProgramBatch(m_modifierOps.data() + entry.m_firstModifierOp, entry.m_modifierOpCount, lanesX, lanesY, lanesZ, controllerCount);
+            for (AZ::u32 controller = 0; controller < controllerCount; ++controller)
+            {
+                if (values[controller] != 0.0f)
+                {
+                    accumulated[controller] += AZ::Vector3(lanesX[controller], lanesY[controller], lanesZ[controller]);
+                }
+            }
+        }
+
+        // Virtual controllers have no event timestamps; each evaluation is one whole step of the caller's clock.
+        TriggerTimeStep timeStep;
+        timeStep.m_deltaTime = deltaTime;
+        timeStep.m_deltaTimeUs = SecondsToMicroseconds(deltaTime);
+        timeStep.m_isDeterministic = m_deterministicTiming;
+
+        TriggerState* evaluatedStates = batch.m_evaluatedStates.data();
+        AZ::u8* hasActiveTriggers = batch.m_hasActiveTriggers.data();
+        AZStd::fill(evaluatedStates, evaluatedStates + controllerCount, TriggerState::None);
+        AZStd::fill(hasActiveTriggers, hasActiveTriggers + controllerCount, AZ::u8(0));
+
+        InputValue* triggerInputs = batch.m_triggerInputs.data();
+        for (AZ::u32 controller = 0; controller < controllerCount; ++controller)
+        {
+            triggerInputs[controller] = InputValue(accumulated[controller]);
+        }
+
+        AZ::u8* isBindingActive = batch.m_isBindingActive.data();
+        TriggerState* triggerResults = batch.m_triggerResults.data();
+        for (AZ::u32 entryIndex = range.m_first; entryIndex < rangeEnd; ++entryIndex)
+        {
+            const DispatchEntry& entry = m_actionEntries[entryIndex];
+            if (entry.m_triggerCount == 0)
+            {
+                continue;
+            }
+
+            const float* values = batch.m_channelValues.data() + static_cast<size_t>(entry.m_channel) * controllerCount;
+            const float* previousValues = batch.m_previousChannelValues.data() + static_cast<size_t>(entry.m_channel) * controllerCount;
+            for (AZ::u32 controller = 0; controller < controllerCount; ++controller)
+            {
+                // Active while held or on the evaluation it was released, as for device channels.
+                isBindingActive[controller] = values[controller] != 0.0f || previousValues[controller] != 0.0f;
+            }
+
+            for (AZ::u32 triggerIndex = 0; triggerIndex < entry.m_triggerCount; ++triggerIndex)
+            {
+                const InputTrigger* trigger = m_compiledTriggers[entry.m_firstTriggerSlot + triggerIndex].get();
+                if (!trigger)
+                {
+                    continue;
+                }
+
+                // One call per trigger for every controller, rather than one per controller.
+                TriggerRuntimeState* runtimeStates =
+                    batch.m_triggerRuntimeStates.data() + static_cast<size_t>(entry.m_firstTriggerSlot + triggerIndex) * controllerCount;
+                trigger->UpdateStates(runtimeStates, triggerInputs, isBindingActive, triggerResults, controllerCount, timeStep);
+                for (AZ::u32 controller = 0; controller < controllerCount; ++controller)
+                {
+                    if (isBindingActive[controller])
+                    {
+                        hasActiveTriggers[controller] = 1;
+                        if (static_cast<int>(triggerResults[controller]) > static_cast<int>(evaluatedStates[controller]))
+                        {
+                            evaluatedStates[controller] = triggerResults[controller];
+                        }
+                    }
+                }
+            }
+        }
+
+        InputValue* actionValues = batch.m_actionValues.data() + actionColumn;
+        TriggerState* triggerStates = batch.m_triggerStates.data() + actionColumn;
+        float* elapsedTimes = batch.m_elapsedTimes.data() + actionColumn;
+        for (AZ::u32 controller = 0; controller < controllerCount; ++controller)
+        {
+            const InputValue value(accumulated[controller]);
+            TriggerState state = evaluatedStates[controller];
+            if (!hasActiveTriggers[controller] && !value.IsZero())
+            {
+                state = TriggerState::Triggered;
+            }
+
+            if (state != TriggerState::None || triggerStates[controller] != TriggerState::None)
+            {
+                elapsedTimes[controller] += deltaTime;
+            }
+            if (state == TriggerState::None || state == TriggerState::Completed || state == TriggerState::Canceled)
+            {
+                elapsedTimes[controller] = 0.0f;
+            }
+
+            actionValues[controller] = value;
+            triggerStates[controller] = state;
+        }
+    }
+
+    InputValue EnhancedInputSystemComponent::GetLateLatchedActionValue(ActionHandle action)
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        if (!IsRegistered(action) || action >= m_actionDispatch.size() || m_dispatchDirty || IsDispatchIndexStale())
+        {
+            return InputValue();
+        }
+
+        // Events still in flight to the sampling thread are newer than anything it has evaluated.
+        DrainSampledEvents();
+
+        const InputPipeline& pipeline = GetDefaultPipeline();
+        AZ::Vector3 accumulated = AZ::Vector3::CreateZero();
+        const DispatchRange& range = m_actionDispatch[action];
+        for (AZ::u32 entryIndex = range.m_first; entryIndex < range.m_first + range.m_count; ++entryIndex)
+        {
+            const DispatchEntry& entry = m_actionEntries[entryIndex];
+            const float rawValue = GetLatestChannelValue(pipeline, entry.m_channel);
+            if (rawValue != 0.0f)
+            {
+                accumulated += ApplyModifiers(InputValue(rawValue), entry);
+            }
+        }
+        return InputValue(accumulated);
+    }
+
+    float EnhancedInputSystemComponent::GetLatestChannelValue(const InputPipeline& pipeline, ChannelIndex channel) const
+    {
+        // Queued events have not reached the channel table yet; the newest one for the channel wins.
+        for (AZ::u32 index = pipeline.m_inputEvents.GetSize(); index-- > 0;)
+        {
+            if (pipeline.m_inputEvents[index].m_channel == channel)
+            {
+                return pipeline.m_inputEvents[index].m_value;
+            }
+        }
+        return pipeline.m_channelStates.GetValue(channel);
+    }
+
+    bool EnhancedInputSystemComponent::IsRegistered(ActionHandle action) const
+    {
+        const ActionStateStorage& states = GetDefaultPipeline().m_actionStates;
+        return action < states.GetSize() && states.m_registered[action] != 0;
+    }
+
+    bool EnhancedInputSystemComponent::OnInputChannelEventFiltered(const AzFramework::InputChannel& inputChannel)
+    {
+        if (m_isReplayingInput)
+        {
+            return false;
+        }
+
+        const AZ::Crc32 channelCrc = inputChannel.GetInputChannelId().GetNameCrc32();
+        const AzFramework::LocalUserId localUserId = inputChannel.GetInputDevice().GetAssignedLocalUserId();
+        const float value = inputChannel.IsStateEnded() ? 0.0f : inputChannel.GetValue();
+        const AZStd::sys_time_t timeUs = AZStd::GetTimeNowMicroSecond();
+
+        if (m_inputRecorder.IsRecording())
+        {
+            m_inputRecorder.WriteEvent(timeUs, localUserId, static_cast<AZ::u32>(channelCrc), value);
+        }
+
+        HandleChannelEvent(channelCrc, localUserId, value, timeUs);
+        return false;
+    }
+
+    void EnhancedInputSystemComponent::HandleChannelEvent(
+        AZ::Crc32 channelCrc, AzFramework::LocalUserId localUserId, float value, AZStd::sys_time_t timeUs)
+    {
+        const ChannelIndex channel = m_channelIndices.FindChannel(channelCrc);
+        if (channel == InvalidChannelIndex)
+        {
+            // No binding has ever referenced this channel.
+            return;
+        }
+
+        SampledInputEvent sampled;
+        sampled.m_localUserId = localUserId;
+        sampled.m_event.m_timeUs = timeUs;
+        sampled.m_event.m_channel = channel;
+        sampled.m_event.m_value = value;
+
+        if (m_isSamplingThreadRunning.load(AZStd::memory_order_relaxed) && m_sampledEvents.TryPush(sampled))
+        {
+            return;
+        }
+
+        // Either there is no sampling thread or it has fallen behind. Holding the lock keeps it from consuming,
+        // so the handoff queue can be drained here first to keep events in order.
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        DrainSampledEvents();
+        QueueInputEvent(RoutePipeline(sampled.m_localUserId), sampled.m_event);
+    }
+
+    bool EnhancedInputSystemComponent::StartInputRecording(const AZStd::string& path)
+    {
+        if (!m_inputRecorder.Start(path.c_str()))
+        {
+            return false;
+        }
+
+        // The recording opens with the state of every pipeline and the events they have queued, so a replay
+        // starts where recording did instead of from whatever state is live then.
+        const AZStd::sys_time_t nowUs = AZStd::GetTimeNowMicroSecond();
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        DrainSampledEvents();
+        AZStd::vector<AZ::u8> state;
+        for (const auto& pipeline : m_pipelines)
+        {
+            if (pipeline->m_isRetired)
+            {
+                continue;
+            }
+            SaveState(pipeline->m_localUserId, state);
+            m_inputRecorder.WriteState(nowUs, pipeline->m_localUserId, state);
+        }
+        for (const auto& pipeline : m_pipelines)
+        {
+            if (pipeline->m_isRetired)
+            {
+                continue;
+            }
+            const InputEventQueue& events = pipeline->m_inputEvents;
+            for (AZ::u32 eventIndex = 0; eventIndex < events.GetSize(); ++eventIndex)
+            {
+                const InputEvent& event = events[eventIndex];
+                m_inputRecorder.WriteEvent(
+                    event.m_timeUs, pipeline->m_localUserId, static_cast<AZ::u32>(m_channelIndices.GetChannelCrc(event.m_channel)),
+                    event.m_value);
+            }
+        }
+        return true;
+    }
+
+    void EnhancedInputSystemComponent::StopInputRecording()
+    {
+        m_inputRecorder.Stop();
+    }
+
+    bool EnhancedInputSystemComponent::StartInputReplay(const AZStd::string& path)
+    {
+        if (m_isSamplingThreadRunning.load(AZStd::memory_order_relaxed))
+        {
+            AZ_Warning("EnhancedInput", false, "Input cannot be replayed while the sampling thread runs on its own clock.");
+            return false;
+        }
+
+        if (!m_inputReplay.Load(path.c_str()))
+        {
+            return false;
+        }
+
+        // Recorded timestamps replace the live clock, so anything queued against the live clock is dropped.
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        for (const auto& pipeline : m_pipelines)
+        {
+            pipeline->m_inputEvents.Clear();
+            pipeline->m_lastTickTimeUs = 0;
+        }
+
+        // Pipelines start from their recorded state. Recordings of an earlier version have none and start from the live state.
+        InputRecord record;
+        while (m_inputReplay.IsAtStateRecord() && m_inputReplay.Read(record))
+        {
+            const AZStd::vector<AZ::u8> state(record.m_state, record.m_state + record.m_stateSize);
+            [[maybe_unused]] const bool restored = RestoreState(record.m_localUserId, state);
+            AZ_Warning(
+                "EnhancedInput", restored,
+                "Recorded input state of local user %u could not be restored; its replay starts from the live state.",
+                static_cast<AZ::u32>(record.m_localUserId));
+        }
+        m_isReplayingInput = true;
+        return true;
+    }
+
+    void EnhancedInputSystemComponent::StopInputReplay()
+    {
+        if (!m_isReplayingInput)
+        {
+            return;
+        }
+
+        m_inputReplay.Close();
+        m_isReplayingInput = false;
+
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        for (const auto& pipeline : m_pipelines)
+        {
+            pipeline->m_inputEvents.Clear();
+            pipeline->m_lastTickTimeUs = 0;
+        }
+    }
+
+    bool EnhancedInputSystemComponent::IsReplayingInput() const
+    {
+        return m_isReplayingInput;
+    }
+
+    void EnhancedInputSystemComponent::ReplayRecordedTick(float& deltaTime, AZStd::sys_time_t& nowUs)
+    {
+        InputRecord record;
+        while (m_inputReplay.Read(record))
+        {
+            if (record.m_type == InputRecordType::Tick)
+            {
+                deltaTime = record.m_deltaTime;
+                nowUs = record.m_timeUs;
+                return;
+            }
+            if (record.m_type == InputRecordType::State)
+            {
+                // Only restored at replay start.
+                continue;
+            }
+
+            HandleChannelEvent(AZ::Crc32(record.m_channelCrc), record.m_localUserId, record.m_value, record.m_timeUs);
+        }
+
+        // The recording is over; this tick and the following ones run on live input again.
+        StopInputReplay();
+    }
+
+    void EnhancedInputSystemComponent::DrainSampledEvents()
+    {
+        // Callers hold m_pipelineMutex, which makes whichever thread this runs on the queue's only consumer.
+        SampledInputEvent sampled;
+        while (m_sampledEvents.TryPop(sampled))
+        {
+            QueueInputEvent(RoutePipeline(sampled.m_localUserId), sampled.m_event);
+        }
+    }
+
+    void EnhancedInputSystemComponent::QueueInputEvent(InputPipeline& pipeline, const InputEvent& event)
+    {
+        InputEvent evicted;
+        if (pipeline.m_inputEvents.Push(event, evicted))
+        {
+            // Older than anything still queued, so applying it now keeps the order intact.
+            pipeline.m_channelStates.SetValue(evicted.m_channel, evicted.m_value);
+        }
+    }
+
+    void EnhancedInputSystemComponent::OnTick(float deltaTime, [[maybe_unused]] AZ::ScriptTimePoint time)
+    {
+        AZStd::sys_time_t nowUs = AZStd::GetTimeNowMicroSecond();
+        if (m_isReplayingInput)
+        {
+            ReplayRecordedTick(deltaTime, nowUs);
+        }
+        else if (m_inputRecorder.IsRecording())
+        {
+            m_inputRecorder.WriteTick(nowUs, deltaTime);
+        }
+
+        AZStd::unique_lock<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        DestroyRetiredPipelines();
+        UpdateCompiledData();
+
+        if (m_isSamplingThreadRunning.load(AZStd::memory_order_relaxed))
+        {
+            // Callbacks run without the lock so they never stall the sampling thread.
+            lock.unlock();
+            DeliverSampledStates();
+            return;
+        }
+
+        if (m_minParallelPipelines > 0 && m_pipelines.size() >= m_minParallelPipelines)
+        {
+            if (AZ::JobContext::GetGlobalContext())
+            {
+                EvaluatePipelinesInParallel(deltaTime, nowUs);
+                return;
+            }
+            AZ_WarningOnce("EnhancedInput", false, "Parallel pipeline evaluation needs a job manager; pipelines are evaluated in turn.");
+        }
+
+        // Indexed rather than iterated, since a callback may add a local user. Removed users are only retired.
+        for (size_t index = 0; index < m_pipelines.size(); ++index)
+        {
+            if (!m_pipelines[index]->m_isRetired)
+            {
+                EvaluatePipeline(*m_pipelines[index], deltaTime, nowUs);
+            }
+        }
+    }
+
+    void EnhancedInputSystemComponent::UpdateCompiledData()
+    {
+        // The index is only ever rebuilt on the game thread that owns the mapping contexts and the channel lookup,
+        // from the tick or from a server's remote frame evaluation.
+        if (m_contextChangeDepth == 0)
+        {
+            ApplyContextChanges();
+        }
+
+        if (m_dispatchDirty || IsDispatchIndexStale())
+        {
+            RebuildDispatchIndex();
+        }
+
+        if (m_combosDirty)
+        {
+            RebuildComboAutomaton();
+        }
+    }
+
+    void EnhancedInputSystemComponent::EvaluatePipeline(InputPipeline& pipeline, float deltaTime, AZStd::sys_time_t nowUs)
+    {
+        if (m_fixedTimestep > 0.0f)
+        {
+            RunFixedSteps(pipeline, deltaTime, nowUs);
+        }
+        else
+        {
+            EvaluateActions(pipeline, deltaTime, nowUs);
+        }
+    }
+
+    void EnhancedInputSystemComponent::EvaluatePipelinesInParallel(float deltaTime, AZStd::sys_time_t nowUs)
+    {
+        // Jobs only read the shared compiled data and write their own pipeline, and never take the pipeline lock. The game
+        // thread holds it throughout, so neither the shared data nor a pipeline's event queue can change underneath them.
+        m_parallelDeltaTime = deltaTime;
+        m_parallelNowUs = nowUs;
+        m_parallelPipelines.clear();
+        AZ::JobCompletion completion;
+        for (const auto& pipeline : m_pipelines)
+        {
+            InputPipeline* target = pipeline.get();
+            if (target->m_isRetired)
+            {
+                continue;
+            }
+
+            if (!target->m_evaluationJob)
+            {
+                // Created once per pipeline and reset for every tick after, so a steady state tick does not allocate.
+                target->m_evaluationJob.reset(AZ::CreateJobFunction(
+                    [this, target]()
+                    {
+                        EvaluatePipeline(*target, m_parallelDeltaTime, m_parallelNowUs);
+                    },
+                    false));
+            }
+
+            target->m_deferNotifications = true;
+            m_parallelPipelines.push_back(target);
+
+            AZ::Job* job = target->m_evaluationJob.get();
+            job->Reset(true);
+            job->SetDependent(&completion);
+            job->Start();
+        }
+        completion.StartAndWaitForCompletion();
+
+        // Pipeline order, then evaluation order within each, so callbacks see the same sequence however jobs were scheduled.
+        // Pipelines removed by a callback meanwhile are only retired, so these pointers stay valid until the next tick.
+        for (InputPipeline* pipeline : m_parallelPipelines)
+        {
+            pipeline->m_deferNotifications = false;
+            DeliverDeferredNotifications(*pipeline);
+        }
+    }
+
+    void EnhancedInputSystemComponent::DeliverDeferredNotifications(InputPipeline& pipeline)
+    {
+        for (size_t index = 0; index < pipeline.m_deferredNotifications.size(); ++index)
+        {
+            SampledActionState& deferred = pipeline.m_deferredNotifications[index];
+            if (IsRegistered(deferred.m_action))
+            {
+                deferred.m_instance.m_action = &m_registeredActions[deferred.m_action];
+                NotifyActionState(deferred.m_action, deferred.m_instance);
+            }
+        }
+        pipeline.m_deferredNotifications.clear();
+    }
+
+    void EnhancedInputSystemComponent::RunFixedSteps(InputPipeline& pipeline, float deltaTime, AZStd::sys_time_t nowUs)
+    {
+        // nowUs is the tick's clock, which a replayed tick takes from the recording, so steps line up with recorded events.
+        const AZStd::sys_time_t stepUs = static_cast<AZStd::sys_time_t>(m_fixedTimestep * 1000000.0f);
+        if (pipeline.m_lastTickTimeUs == 0)
+        {
+            pipeline.m_lastTickTimeUs = nowUs - static_cast<AZStd::sys_time_t>(deltaTime * 1000000.0f);
+        }
+
+        const ActionStateStorage& states = pipeline.m_actionStates;
+        const size_t actionCount = states.GetSize();
+        pipeline.m_fixedStepValues.resize(static_cast<size_t>(m_maxFixedSteps) * actionCount);
+
+        // Same accumulation as the physics system, so equal timesteps give both the same number of steps per frame.
+        pipeline.m_fixedStepAccumulator += deltaTime;
+        pipeline.m_fixedStepCount = 0;
+        while (pipeline.m_fixedStepAccumulator >= m_fixedTimestep && pipeline.m_fixedStepCount < m_maxFixedSteps)
+        {
+            pipeline.m_fixedStepAccumulator -= m_fixedTimestep;
+            EvaluateActions(pipeline, m_fixedTimestep, pipeline.m_lastTickTimeUs + stepUs);
+
+            AZStd::copy(states.m_values.begin(), states.m_values.end(),
+                pipeline.m_fixedStepValues.begin() + pipeline.m_fixedStepCount * actionCount);
+            ++pipeline.m_fixedStepCount;
+        }
+
+        if (pipeline.m_fixedStepAccumulator >= m_fixedTimestep)
+        {
+            // Too far behind to catch up; drop the backlog instead of spiralling and resume from now.
+            pipeline.m_fixedStepAccumulator = 0.0f;
+            pipeline.m_lastTickTimeUs = nowUs;
+        }
+    }
+
+    AZ::u32 EnhancedInputSystemComponent::GetFixedStepCount() const
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        return GetDefaultPipeline().m_fixedStepCount;
+    }
+
+    InputValue EnhancedInputSystemComponent::GetFixedStepActionValue(ActionHandle action, AZ::u32 step) const
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        return GetFixedStepActionValue(GetDefaultPipeline(), action, step);
+    }
+
+    AZ::u32 EnhancedInputSystemComponent::GetFixedStepCount(AzFramework::LocalUserId localUserId) const
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        const InputPipeline* pipeline = FindPipeline(localUserId);
+        return pipeline ? pipeline->m_fixedStepCount : 0;
+    }
+
+    InputValue EnhancedInputSystemComponent::GetFixedStepActionValue(AzFramework::LocalUserId localUserId, ActionHandle action, AZ::u32 step) const
+    {
+        AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+        const InputPipeline* pipeline = FindPipeline(localUserId);
+        return pipeline ? GetFixedStepActionValue(*pipeline, action, step) : InputValue();
+    }
+
+    InputValue EnhancedInputSystemComponent::GetFixedStepActionValue(const InputPipeline& pipeline, ActionHandle action, AZ::u32 step) const
+    {
+        const size_t actionCount = pipeline.m_actionStates.GetSize();
+        if (!IsRegistered(action) || step >= pipeline.m_fixedStepCount || pipeline.m_fixedStepValues.size() < (step + 1) * actionCount)
+        {
+            return InputValue();
+        }
+        return pipeline.m_fixedStepValues[step * actionCount + action];
+    }
+
+    void EnhancedInputSystemComponent::EvaluateActions(InputPipeline& pipeline, float deltaTime, AZStd::sys_time_t frameEndUs)
+    {
+        AllocationTrackingScope allocationScope;
+
+        const AZStd::sys_time_t frameStartUs = pipeline.m_lastTickTimeUs != 0
+            ? pipeline.m_lastTickTimeUs
+            : frameEndUs - static_cast<AZStd::sys_time_t>(deltaTime * 1000000.0f);
+        pipeline.m_lastTickTimeUs = frameEndUs;
+
+        ReplayInputEvents(pipeline, frameStartUs, frameEndUs);
+        pipeline.m_evaluationTimeUs = frameEndUs;
+
+        ActionStateStorage& states = pipeline.m_actionStates;
+
+        if (!m_incrementalTick)
+        {
+            for (ActionHandle handle = 0; handle < states.GetSize(); ++handle)
+            {
+                MarkActionDirty(pipeline, handle);
+            }
+        }
+
+        for (const ChannelIndex channel : pipeline.m_channelStates.GetChangedChannels())
+        {
+            if (channel >= m_channelDispatch.size())
+            {
+                continue;
+            }
+
+            const DispatchRange& range = m_channelDispatch[channel];
+            for (AZ::u32 entryIndex = range.m_first; entryIndex < range.m_first + range.m_count; ++entryIndex)
+            {
+                MarkActionDirty(pipeline, m_channelEntries[entryIndex].m_action);
+            }
+        }
+
+        // Swap first so actions re-dirtied by callbacks during notification land in next tick's list.
+        // Both lists need room for every handle; RegisterAction only grows the one that is not being iterated.
+        pipeline.m_tickingActions.reserve(states.GetSize());
+        AZStd::swap(pipeline.m_dirtyActions, pipeline.m_tickingActions);
+        pipeline.m_dirtyActions.clear();
+
+        for (const ActionHandle handle : pipeline.m_tickingActions)
+        {
+            states.m_dirty[handle] = 0;
+            if (!states.m_registered[handle])
+            {
+                continue;
+            }
+
+            // Whatever part of the frame was not already consumed by sub-frame evaluations.
+            UpdateAction(pipeline, handle, AZ::GetMax(deltaTime - states.m_substepTimes[handle], 0.0f));
+            states.m_substepTimes[handle] = 0.0f;
+
+            if (ShouldStayDirty(pipeline, handle))
+            {
+                MarkActionDirty(pipeline, handle);
+            }
+        }
+        pipeline.m_tickingActions.clear();
+
+        for (const ActionHandle combo : pipeline.m_firedCombos)
+        {
+            pipeline.m_isComboFired[combo] = 0;
+        }
+        pipeline.m_firedCombos.clear();
+
+        pipeline.m_channelStates.ClearChanged();
+
+        AZ_Error("EnhancedInput", !m_trackTickAllocations || allocationScope.GetAllocationCount() == 0,
+            "%u allocations by runtime containers during the tick.", allocationScope.GetAllocationCount());
+    }
+
+    void EnhancedInputSystemComponent::ReplayInputEvents(InputPipeline& pipeline, AZStd::sys_time_t frameStartUs, AZStd::sys_time_t frameEndUs)
+    {
+        const InputEventQueue& inputEvents = pipeline.m_inputEvents;
+
+        // Events arrive in time order, so everything after the first one past the frame belongs to a later step.
+        AZ::u32 eventCount = 0;
+        while (eventCount < inputEvents.GetSize() && inputEvents[eventCount].m_timeUs <= frameEndUs)
+        {
+            ++eventCount;
+        }
+
+        if (eventCount == 0)
+        {
+            return;
+        }
+
+        // Walk backwards once to find each channel's final event of the frame. Only earlier events of a channel,
+        // which would otherwise be overwritten, need their own evaluation at event time. Deterministic timing
+        // evaluates every event at its own time, so trigger timers start exactly when the input did.
+        if (m_deterministicTiming)
+        {
+            AZStd::fill(pipeline.m_isLastEventForChannel.begin(), pipeline.m_isLastEventForChannel.begin() + eventCount, false);
+        }
+        else
+        {
+            for (AZ::u32 index = eventCount; index-- > 0;)
+            {
+                const ChannelIndex channel = inputEvents[index].m_channel;
+                AZ::u64& word = pipeline.m_replayedChannels[channel / 64];
+                const AZ::u64 bit = AZ::u64(1) << (channel % 64);
+                pipeline.m_isLastEventForChannel[index] = (word & bit) == 0;
+                word |= bit;
+            }
+            AZStd::fill(pipeline.m_replayedChannels.begin(), pipeline.m_replayedChannels.end(), AZ::u64(0));
+        }
+
+        ActionStateStorage& states = pipeline.m_actionStates;
+        for (AZ::u32 index = 0; index < eventCount; ++index)
+        {
+            const InputEvent& event = inputEvents[index];
+            pipeline.m_channelStates.SetValue(event.m_channel, event.m_value);
+
+            if (pipeline.m_isLastEventForChannel[index] || event.m_channel >= m_channelDispatch.size())
+            {
+                continue;
+            }
+
+            pipeline.m_evaluationTimeUs = event.m_timeUs;
+            const float eventTime = static_cast<float>(AZ::GetMax(event.m_timeUs - frameStartUs, AZStd::sys_time_t(0))) / 1000000.0f;
+            const DispatchRange& range = m_channelDispatch[event.m_channel];
+            for (AZ::u32 entryIndex = range.m_first; entryIndex < range.m_first + range.m_count; ++entryIndex)
+            {
+                const ActionHandle handle = m_channelEntries[entryIndex].m_action;
+                const float substepTime = AZ::GetMax(eventTime - states.m_substepTimes[handle], 0.0f);
+                UpdateAction(pipeline, handle, substepTime);
+                states.m_substepTimes[handle] += substepTime;
+                MarkActionDirty(pipeline, handle);
+            }
+        }
+
+        pipeline.m_inputEvents.PopFront(eventCount);
+    }
+
+    void EnhancedInputSystemComponent::UpdateAction(InputPipeline& pipeline, ActionHandle handle, float deltaTime)
+    {
+        ActionStateStorage& states = pipeline.m_actionStates;
+        if (handle >= m_actionDispatch.size() || (handle < pipeline.m_isComboFired.size() && pipeline.m_isComboFired[handle]))
+        {
+            return;
+        }
+
+        const ChannelStateTable& channelStates = pipeline.m_channelStates;
+
+        // A binding contributes while its channel is held or when it changed this tick, so triggers also observe the release.
+        auto isBindingActive = [&channelStates](const DispatchEntry& entry)
+        {
+            return channelStates.GetValue(entry.m_channel) != 0.0f || channelStates.HasChanged(entry.m_channel);
+        };
+
+        const DispatchRange& range = m_actionDispatch[handle];
+        const AZ::u32 rangeEnd = range.m_first + range.m_count;
+
+        AZ::Vector3 accumulated = AZ::Vector3::CreateZero();
+        for (AZ::u32 entryIndex = range.m_first; entryIndex < rangeEnd; ++entryIndex)
+        {
+            const DispatchEntry& entry = m_actionEntries[entryIndex];
+            if (isBindingActive(entry))
+            {
+                InputValue rawValue(channelStates.GetValue(entry.m_channel));
+                accumulated += ApplyModifiers(rawValue, entry);
+            }
+        }
+        const InputValue accumulatedValue(accumulated);
+
+        TriggerTimeStep timeStep;
+        timeStep.m_deltaTime = deltaTime;
+        timeStep.m_isDeterministic = m_deterministicTiming;
+
+        // Triggers see the value accumulated over all of the action's bindings, so they run once accumulation is complete.
+        bool hasActiveTriggers = false;
+        bool hasRunningTimer = false;
+        TriggerState triggerState = TriggerState::None;
+        for (AZ::u32 entryIndex = range.m_first; entryIndex < rangeEnd; ++entryIndex)
+        {
+            const DispatchEntry& entry = m_actionEntries[entryIndex];
+            if (!isBindingActive(entry))
+            {
+                continue;
+            }
+
+            for (AZ::u32 triggerIndex = 0; triggerIndex < entry.m_triggerCount; ++triggerIndex)
+            {
+                const InputTrigger* trigger = m_compiledTriggers[entry.m_firstTriggerSlot + triggerIndex].get();
+                if (!trigger)
+                {
+                    continue;
+                }
+
+                TriggerRuntimeState& runtimeState = pipeline.m_triggerStates[entry.m_firstTriggerSlot + triggerIndex];
+                if (m_deterministicTiming)
+                {
+                    // Measured from this trigger's own previous update, so it is the same however the time in between was
+                    // sliced. A trigger at rest has no timer to advance; its first update after rest starts timing then.
+                    const bool wasAtRest = runtimeState.m_state == TriggerState::None && !trigger->IsTimerRunning(runtimeState);
+                    timeStep.m_deltaTimeUs =
+                        wasAtRest ? 0 : AZ::GetMax(pipeline.m_evaluationTimeUs - runtimeState.m_updateTimeUs, AZStd::sys_time_t(0));
+                    timeStep.m_deltaTime = static_cast<float>(timeStep.m_deltaTimeUs) / 1000000.0f;
+                    runtimeState.m_updateTimeUs = pipeline.m_evaluationTimeUs;
+                }
+
+                hasActiveTriggers = true;
+                TriggerState state = trigger->UpdateState(runtimeState, accumulatedValue, timeStep);
+                if (static_cast<int>(state) > static_cast<int>(triggerState))
+                {
+                    triggerState = state;
+                }
+                hasRunningTimer = hasRunningTimer || trigger->IsTimerRunning(runtimeState);
+            }
+        }
+
+        if (!hasActiveTriggers && !accumulatedValue.IsZero())
+        {
+            triggerState = TriggerState::Triggered;
+        }
+
+        states.m_previousValues[handle] = states.m_values[handle];
+        states.m_values[handle] = accumulatedValue;
+        states.m_hasRunningTimer[handle] = hasRunningTimer ? 1 : 0;
+
+        TriggerState previousState = states.m_triggerStates[handle];
+        states.m_triggerStates[handle] = triggerState;
+
+        if (triggerState != TriggerState::None || previousState != TriggerState::None)
+        {
+            states.m_elapsedTimes[handle] += deltaTime;
+            if (triggerState == TriggerState::Triggered)
+            {
+                states.m_triggeredTimes[handle] = states.m_elapsedTimes[handle];
+            }
+
+            PublishActionState(pipeline, handle);
+        }
+
+        // Transitions only: a held binding reports Triggered every update, which would fill the history with repeats and keep
+        // WasTriggeredWithin true for as long as it is held. Pulses pass through Ongoing between fires, so each one is kept.
+        if (triggerState != previousState)
+        {
+            pipeline.m_actionHistories[handle].Record(pipeline.m_evaluationTimeUs, triggerState, accumulatedValue, states.m_elapsedTimes[handle]);
+        }
+
+        if (triggerState == TriggerState::None || triggerState == TriggerState::Completed || triggerState == TriggerState::Canceled)
+        {
+            states.m_elapsedTimes[handle] = 0.0f;
+        }
+
+        if (IsActiveState(triggerState) && !IsActiveState(previousState))
+        {
+            OnActionActivated(pipeline, handle);
+        }
+    }
+
+    void EnhancedInputSystemComponent::OnActionActivated(InputPipeline& pipeline, ActionHandle action)
+    {
+        if (m_comboAutomaton.IsEmpty())
+        {
+            return;
+        }
+
+        // A fired combo is itself an activation and may complete another combo, appending past this call's range.
+        // Each combo is claimed as soon as it completes and fires at most once per evaluation, so however deep that
+        // nests the list holds at most one claimed entry per combo plus what the innermost Advance just appended.
+        RuntimeVector<ActionHandle>& completedCombos = pipeline.m_completedCombos;
+        const size_t firstCompleted = completedCombos.size();
+        m_comboAutomaton.Advance(pipeline.m_comboMatchState, action, pipeline.m_evaluationTimeUs, completedCombos);
+        size_t lastCompleted = firstCompleted;
+        for (size_t index = firstCompleted; index < completedCombos.size(); ++index)
+        {
+            const ActionHandle combo = completedCombos[index];
+            if (IsRegistered(combo) && !pipeline.m_isComboFired[combo])
+            {
+                pipeline.m_isComboFired[combo] = 1;
+                pipeline.m_firedCombos.push_back(combo);
+                completedCombos[lastCompleted++] = combo;
+            }
+        }
+        completedCombos.resize(lastCompleted);
+
+        for (size_t index = firstCompleted; index < lastCompleted; ++index)
+        {
+            FireCombo(pipeline, completedCombos[index]);
+        }
+        completedCombos.resize(firstCompleted);
+    }
+
+    void EnhancedInputSystemComponent::FireCombo(InputPipeline& pipeline, ActionHandle combo)
+    {
+        ActionStateStorage& states = pipeline.m_actionStates;
+        const TriggerState previousState = states.m_triggerStates[combo];
+        states.m_previousValues[combo] = states.m_values[combo];
+        states.m_values[combo] = InputValue(true);
+        states.m_triggerStates[combo] = TriggerState::Triggered;
+        states.m_elapsedTimes[combo] = 0.0f;
+        states.m_triggeredTimes[combo] = 0.0f;
+
+        // Evaluated again next tick, which finds no bindings held and returns it to None.
+        MarkActionDirty(pipeline, combo);
+
+        PublishActionState(pipeline, combo);
+        pipeline.m_actionHistories[combo].Record(pipeline.m_evaluationTimeUs, TriggerState::Triggered, states.m_values[combo], 0.0f);
+
+        if (!IsActiveState(previousState))
+        {
+            OnActionActivated(pipeline, combo);
+        }
+    }
+
+    void EnhancedInputSystemComponent::PublishActionState(InputPipeline& pipeline, ActionHandle action)
+    {
+        if (pipeline.m_isRemote)
+        {
+            return;
+        }
+
+        if (pipeline.m_deferNotifications)
+        {
+            SampledActionState& deferred = pipeline.m_deferredNotifications.emplace_back();
+            deferred.m_action = action;
+            pipeline.m_actionStates.BuildInstance(action, nullptr, deferred.m_instance);
+            deferred.m_instance.m_localUserId = pipeline.m_localUserId;
+            return;
+        }
+
+        if (!m_isSamplingThreadRunning.load(AZStd::memory_order_relaxed))
+        {
+            InputActionInstance instance;
+            pipeline.m_actionStates.BuildInstance(action, &m_registeredActions[action], instance);
+            instance.m_localUserId = pipeline.m_localUserId;
+            NotifyActionState(action, instance);
+            return;
+        }
+
+        // The action pointer is filled in on delivery, on the game thread that owns the registered actions.
+        SampledActionState sampled;
+        sampled.m_action = action;
+        pipeline.m_actionStates.BuildInstance(action, nullptr, sampled.m_instance);
+        sampled.m_instance.m_localUserId = pipeline.m_localUserId;
+
+        if (!m_unsentSampledStates.empty() || !m_sampledStates.TryPush(sampled))
+        {
+            m_unsentSampledStates.push_back(sampled);
+        }
+    }
+
+    void EnhancedInputSystemComponent::StartSamplingThread()
+    {
+        if (m_isSamplingThreadRunning.load(AZStd::memory_order_acquire))
+        {
+            return;
+        }
+
+        // The sampling thread evaluates on its own clock, which leaves no place for whole fixed steps or for the tick's
+        // parallel jobs. Rather than have it override them silently, it is not started alongside either.
+        if (m_fixedTimestep > 0.0f || m_minParallelPipelines > 0)
+        {
+            AZ_Warning("EnhancedInput", false,
+                "The sampling thread cannot run with a fixed timestep or parallel pipeline evaluation; it was not started.");
+            return;
+        }
+
+        {
+            AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+            for (const auto& pipeline : m_pipelines)
+            {
+                pipeline->m_lastTickTimeUs = 0;
+            }
+            // Room for another full queue's worth, so a stalled game thread does not make the sampling thread allocate.
+            m_unsentSampledStates.reserve(m_sampledStates.Capacity);
+        }
+
+        m_isSamplingThreadRunning.store(true, AZStd::memory_order_release);
+
+        AZStd::thread_desc threadDesc;
+        threadDesc.m_name = "EnhancedInput Sampling";
+        m_samplingThread = AZStd::thread(threadDesc, [this]() { RunSamplingThread(); });
+    }
+
+    void EnhancedInputSystemComponent::StopSamplingThread()
+    {
+        if (!m_samplingThread.joinable())
+        {
+            return;
+        }
+
+        m_isSamplingThreadRunning.store(false, AZStd::memory_order_release);
+        m_samplingThread.join();
+    }
+
+    void EnhancedInputSystemComponent::RunSamplingThread()
+    {
+        const AZStd::sys_time_t intervalUs = 1000000 / AZ::GetMax(m_samplingRateHz, 1u);
+        AZStd::sys_time_t lastEvaluationUs = AZStd::GetTimeNowMicroSecond();
+        AZStd::sys_time_t nextSampleUs = lastEvaluationUs + intervalUs;
+
+        while (m_isSamplingThreadRunning.load(AZStd::memory_order_acquire))
+        {
+            const AZStd::sys_time_t sleepUs = nextSampleUs - AZStd::GetTimeNowMicroSecond();
+            if (sleepUs > 0)
+            {
+                AZStd::this_thread::sleep_for(AZStd::chrono::microseconds(sleepUs));
+            }
+
+            const AZStd::sys_time_t nowUs = AZStd::GetTimeNowMicroSecond();
+            // After a stall, carry on from now rather than bursting to catch up.
+            nextSampleUs = AZ::GetMax(nextSampleUs + intervalUs, nowUs);
+
+            AZStd::lock_guard<AZStd::recursive_mutex> lock(m_pipelineMutex);
+
+            size_t sentCount = 0;
+            while (sentCount < m_unsentSampledStates.size() && m_sampledStates.TryPush(m_unsentSampledStates[sentCount]))
+            {
+                ++sentCount;
+            }
+            m_unsentSampledStates.erase(m_unsentSampledStates.begin(), m_unsentSampledStates.begin() + sentCount);
+
+            DrainSampledEvents();
+
+            // The index owns everything evaluation reads, so edits to contexts cannot pull it out from under this thread.
+            // Once it is known to be out of date, wait for the game thread to rebuild it.
+            if (m_dispatchDirty || m_combosDirty)
+            {
+                continue;
+            }
+
+            const float deltaTime = static_cast<float>(nowUs - lastEvaluationUs) / 1000000.0f;
+            for (const auto& pipeline : m_pipelines)
+            {
+                if (!pipeline->m_isRetired)
+                {
+                    EvaluateActions(*pipeline, deltaTime, nowUs);
+                }
+            }
+            lastEvaluationUs = nowUs;
+        }
+    }
+
+    void EnhancedInputSystemComponent::DeliverSampledStates()
+    {
+        SampledActionState sampled;
+        while (m_sampledStates.TryPop(sampled))
+        {
+            if (!IsRegistered(sampled.m_action))
+            {
+                continue;
+            }
+
+            sampled.m_instance.m_action = &m_registeredActions[sampled.m_action];
+            NotifyActionState(sampled.m_action, sampled.m_instance);
+        }
+    }
+
+    void EnhancedInputSystemComponent::MarkActionDirty(InputPipeline& pipeline, ActionHandle action)
+    {
+        ActionStateStorage& states = pipeline.m_actionStates;
+        if (states.m_dirty[action])
+        {
+            return;
+        }
+
+        states.m_dirty[action] = 1;
+        pipeline.m_dirtyActions.push_back(action);
+    }
+
+    bool EnhancedInputSystemComponent::ShouldStayDirty(const InputPipeline& pipeline, ActionHandle action) const
+    {
+        // An action left out of the tick must end up exactly where a full update would have put it:
+        // zero value and previous value, no trigger state and no armed trigger timer.
+        const ActionStateStorage& states = pipeline.m_actionStates;
+        return states.m_triggerStates[action] != TriggerState::None ||
+            states.m_hasRunningTimer[action] ||
+            !states.m_values[action].IsZero() ||
+            !states.m_previousValues[action].IsZero();
+    }
+
+    void EnhancedInputSystemComponent::ApplyContextChanges()
+    {
+        if (m_pendingContextChanges.empty())
+        {
+            return;
+        }
+
+        // Replay the queued changes against removal flags and a name index built once, then compact and sort a
+        // single time, however many changes were queued.
+        AZStd::vector<AZ::u8> isRemoved(m_activeContexts.size(), 0);
+        AZStd::unordered_map<AZStd::string, AZStd::vector<size_t>> indicesByName;
+        for (size_t index = 0; index < m_activeContexts.size(); ++index)
+        {
+            indicesByName[m_activeContexts[index].m_context->GetName()].push_back(index);
+        }
+
+        for (ContextChange& change : m_pendingContextChanges)
+        {
+            switch (change.m_type)
+            {
+            case ContextChangeType::Add:
+            {
+                // A context that is already active only takes the new priority, so its bindings never count twice.
+                AZStd::vector<size_t>& indices = indicesByName[change.m_context.m_context->GetName()];
+                auto activeIt = AZStd::find_if(indices.begin(), indices.end(),
+                    [this, &change, &isRemoved](size_t index)
+                    {
+                        return !isRemoved[index] && m_activeContexts[index].m_context == change.m_context.m_context;
+                    });
+                if (activeIt != indices.end())
+                {
+                    m_activeContexts[*activeIt].m_priority = change.m_context.m_priority;
+                    break;
+                }
+
+                indices.push_back(m_activeContexts.size());
+                m_activeContexts.push_back(AZStd::move(change.m_context));
+                isRemoved.push_back(0);
+                break;
+            }
+            case ContextChangeType::Remove:
+                if (auto nameIt = indicesByName.find(change.m_contextName); nameIt != indicesByName.end())
+                {
+                    for (const size_t index : nameIt->second)
+                    {
+                        if (!isRemoved[index])
+                        {
+                            isRemoved[index] = 1;
+                            break;
+                        }
+                    }
+                }
+                break;
+            case ContextChangeType::Clear:
+                AZStd::fill(isRemoved.begin(), isRemoved.end(), AZ::u8(1));
+                break;
+            }
+        }
+        m_pendingContextChanges.clear();
+
+        size_t keptCount = 0;
+        for (size_t index = 0; index < m_activeContexts.size(); ++index)
+        {
+            if (!isRemoved[index])
+            {
+                m_activeContexts[keptCount++] = AZStd::move(m_activeContexts[index]);
+            }
+        }
+        m_activeContexts.erase(m_activeContexts.begin() + keptCount, m_activeContexts.end());
+        AZStd::stable_sort(m_activeContexts.begin(), m_activeContexts.end());
+
+        m_dispatchDirty = true;
+    }
+
+    bool EnhancedInputSystemComponent::IsDispatchIndexStale() const
+    {
+        if (m_compiledRevisions.size() != m_activeContexts.size())
+        {
+            return true;
+        }
+
+        auto revisionIt = m_compiledRevisions.begin();
+        for (const auto& activeContext : m_activeContexts)
+        {
+            if (revisionIt->m_context != activeContext.m_context ||
+                (activeContext.m_context && revisionIt->m_revision != activeContext.m_context->GetRevision()))
+            {
+                return true;
+            }
+            ++revisionIt;
+        }
+        return false;
+    }
+
+    void EnhancedInputSystemComponent::RebuildDispatchIndex()
+    {
+        // Bindings that stay compiled keep their trigger states in every pipeline, so a held trigger survives another
+        // context being added. A binding is recognized by its context and, if that context is unchanged, its index
+        // there; otherwise by the id AddBinding gave it. Moves are collected while compiling and applied afterwards.
+        AZStd::swap(m_previousRevisions, m_compiledRevisions);
+        AZStd::swap(m_previousBindings, m_compiledBindings);
+        m_compiledRevisions.clear();
+        m_compiledBindings.clear();
+        struct TriggerSlotMove
+        {
+            AZ::u32 m_from = 0;
+            AZ::u32 m_to = 0;
+            AZ::u32 m_count = 0;
+        };
+        AZStd::vector<TriggerSlotMove> triggerSlotMoves;
+        m_triggerSlotCount = 0;
+        m_compiledTriggers.clear();
+        m_modifierOps.clear();
+
+        // Gather entries per channel and per action in context priority order, then flatten them so each
+        // channel and each action owns one contiguous range.
+        AZStd::vector<AZStd::vector<DispatchEntry>> entriesByChannel;
+        AZStd::vector<AZStd::vector<DispatchEntry>> entriesByAction(m_registeredActions.size());
+
+        // Channels claimed by consuming actions of higher-priority contexts. Each context's own claims are merged in
+        // only after the whole context is compiled, so bindings sharing a channel within one context all stay live.
+        // Masked bindings are compiled out entirely and cost nothing at tick time.
+        AZStd::vector<AZ::u64> consumedChannels;
+        AZStd::vector<AZ::u64> contextChannels;
+
+        for (const auto& activeContext : m_activeContexts)
+        {
+            CompiledContextRevision& compiledContext = m_compiledRevisions.emplace_back();
+            compiledContext.m_context = activeContext.m_context;
+            compiledContext.m_revision = activeContext.m_context ? activeContext.m_context->GetRevision() : 0;
+            compiledContext.m_firstBinding = static_cast<AZ::u32>(m_compiledBindings.size());
+
+            if (!activeContext.m_context)
+            {
+                continue;
+            }
+
+            // Bindings compiled from this context last time, walked alongside its bindings. Both are in binding order,
+            // and so are the ids, since AddBinding hands them out increasing and removal keeps the order.
+            const CompiledBinding* previousBinding = nullptr;
+            const CompiledBinding* previousBindingsEnd = nullptr;
+            bool isContextUnchanged = false;
+            for (const CompiledContextRevision& previousContext : m_previousRevisions)
+            {
+                if (previousContext.m_context == activeContext.m_context)
+                {
+                    previousBinding = m_previousBindings.data() + previousContext.m_firstBinding;
+                    previousBindingsEnd = previousBinding + previousContext.m_bindingCount;
+                    isContextUnchanged = previousContext.m_revision == compiledContext.m_revision;
+                    break;
+                }
+            }
+
+            contextChannels.assign(consumedChannels.size(), 0);
+
+            // Through a const reference, since the mutable accessor counts as an edit and would leave the index stale.
+            const InputMappingContext& context = *activeContext.m_context;
+            const AZStd::vector<InputActionBinding>& bindings = context.GetBindings();
+            for (AZ::u32 bindingIndex = 0; bindingIndex < bindings.size(); ++bindingIndex)
+            {
+                const InputActionBinding& binding = bindings[bindingIndex];
+                const ActionHandle handle = GetActionHandle(binding.m_actionName);
+                if (handle == InvalidActionHandle)
+                {
+                    continue;
+                }
+
+                const ChannelIndex channel = m_channelIndices.RegisterChannel(binding.m_inputChannelId.GetNameCrc32());
+                const size_t channelWord = channel / 64;
+                const AZ::u64 channelBit = AZ::u64(1) << (channel % 64);
+                if (channelWord < consumedChannels.size() && (consumedChannels[channelWord] & channelBit) != 0)
+                {
+                    continue;
+                }
+
+                if (m_registeredActions[handle].GetConsumeInput())
+                {
+                    if (channelWord >= contextChannels.size())
+                    {
+                        contextChannels.resize(channelWord + 1, 0);
+                    }
+                    contextChannels[channelWord] |= channelBit;
+                }
+
+                if (channel >= entriesByChannel.size())
+                {
+                    entriesByChannel.resize(channel + 1);
+                }
+
+                DispatchEntry entry{ handle, channel };
+                entry.m_firstTriggerSlot = m_triggerSlotCount;
+                entry.m_triggerCount = static_cast<AZ::u32>(binding.m_triggers.size());
+                m_triggerSlotCount += entry.m_triggerCount;
+                m_compiledTriggers.insert(m_compiledTriggers.end(), binding.m_triggers.begin(), binding.m_triggers.end());
+
+                ModifierProgramBuilder modifierProgram(m_modifierOps);
+                modifierProgram.AddChain(binding.m_modifiers);
+                entry.m_firstModifierOp = modifierProgram.GetFirstOp();
+                entry.m_modifierOpCount = modifierProgram.GetOpCount();
+
+                m_compiledBindings.push_back({ bindingIndex, binding.m_id, entry.m_firstTriggerSlot, entry.m_triggerCount });
+
+                const AZ::u32 bindingKey = isContextUnchanged ? bindingIndex : binding.m_id;
+                if (isContextUnchanged || bindingKey != 0)
+                {
+                    auto previousKey = [isContextUnchanged](const CompiledBinding& previous)
+                    {
+                        return isContextUnchanged ? previous.m_bindingIndex : previous.m_bindingId;
+                    };
+                    while (previousBinding != previousBindingsEnd && previousKey(*previousBinding) < bindingKey)
+                    {
+                        ++previousBinding;
+                    }
+                    if (previousBinding != previousBindingsEnd && previousKey(*previousBinding) == bindingKey &&
+                        previousBinding->m_triggerCount == entry.m_triggerCount && entry.m_triggerCount > 0)
+                    {
+                        triggerSlotMoves.push_back({ previousBinding->m_firstTriggerSlot, entry.m_firstTriggerSlot, entry.m_triggerCount });
+                    }
+                }
+
+                entriesByChannel[channel].push_back(entry);
+                entriesByAction[handle].push_back(entry);
+            }
+
+            if (consumedChannels.size() < contextChannels.size())
+            {
+                consumedChannels.resize(contextChannels.size(), 0);
+            }
+            for (size_t word = 0; word < contextChannels.size(); ++word)
+            {
+                consumedChannels[word] |= contextChannels[word];
+            }
+            compiledContext.m_bindingCount = static_cast<AZ::u32>(m_compiledBindings.size()) - compiledContext.m_firstBinding;
+        }
+        m_previousRevisions.clear();
+        m_previousBindings.clear();
+
+        ForEachPipeline(
+            [this, &triggerSlotMoves](InputPipeline& pipeline)
+            {
+                RuntimeVector<TriggerRuntimeState> previousTriggerStates = AZStd::move(pipeline.m_triggerStates);
+                pipeline.m_triggerStates.clear();
+                pipeline.m_triggerStates.resize(m_triggerSlotCount);
+                for (const TriggerSlotMove& move : triggerSlotMoves)
+                {
+                    AZStd::copy(
+                        previousTriggerStates.begin() + move.m_from,
+                        previousTriggerStates.begin() + move.m_from + move.m_count,
+                        pipeline.m_triggerStates.begin() + move.m_to);
+                }
+
+                SizePipeline(pipeline);
+            });
+
+        // Virtual controllers keep theirs the same way, with one column of controllers per slot.
+        VirtualControllerBatch& batch = m_virtualControllers;
+        const size_t controllerCount = batch.m_controllerCount;
+        RuntimeVector<TriggerRuntimeState> previousVirtualStates = AZStd::move(batch.m_triggerRuntimeStates);
+        batch.m_triggerRuntimeStates.clear();
+        batch.m_triggerRuntimeStates.resize(controllerCount * m_triggerSlotCount);
+        for (const TriggerSlotMove& move : triggerSlotMoves)
+        {
+            if ((move.m_from + move.m_count) * controllerCount <= previousVirtualStates.size())
+            {
+                AZStd::copy(
+                    previousVirtualStates.begin() + move.m_from * controllerCount,
+                    previousVirtualStates.begin() + (move.m_from + move.m_count) * controllerCount,
+                    batch.m_triggerRuntimeStates.begin() + move.m_to * controllerCount);
+            }
+        }
+        SizeVirtualControllers();
+
+        FlattenDispatchEntries(entriesByChannel, m_channelDispatch, m_channelEntries);
+        FlattenDispatchEntries(entriesByAction, m_actionDispatch, m_actionEntries);
+
+        m_dispatchDirty = false;
+    }
+
+    void EnhancedInputSystemComponent::RebuildComboAutomaton()
+    {
+        AZStd::vector<ComboSequence> sequences;
+        sequences.reserve(m_comboDefinitions.size());
+        for (const ComboDefinition& definition : m_comboDefinitions)
+        {
+            ComboSequence sequence;
+            sequence.m_combo = GetActionHandle(definition.m_name);
+            sequence.m_maxStepIntervalUs = static_cast<AZStd::sys_time_t>(definition.m_maxStepInterval * 1000000.0f);
+            for (const AZStd::string& stepName : definition.m_steps)
+            {
+                const ActionHandle step = GetActionHandle(stepName);
+                if (step == InvalidActionHandle)
+                {
+                    // Left out until every step is registered.
+                    sequence.m_steps.clear();
+                    break;
+                }
+                sequence.m_steps.push_back(step);
+            }
+
+            if (sequence.m_combo != InvalidActionHandle && !sequence.m_steps.empty())
+            {
+                sequences.push_back(AZStd::move(sequence));
+            }
+        }
+
+        m_comboAutomaton.Build(sequences, m_registeredActions.size());
+
+        const size_t comboCount = m_comboAutomaton.GetComboCount();
+        ForEachPipeline(
+            [this, comboCount](InputPipeline& pipeline)
+            {
+                m_comboAutomaton.ResetState(pipeline.m_comboMatchState);
+                pipeline.m_completedCombos.clear();
+                pipeline.m_completedCombos.reserve(comboCount * 2);
+                pipeline.m_firedCombos.clear();
+                pipeline.m_firedCombos.reserve(comboCount);
+                pipeline.m_isComboFired.assign(m_registeredActions.size(), 0);
+            });
+
+        m_combosDirty = false;
+    }
+
+    void EnhancedInputSystemComponent::NotifyActionState(ActionHandle action, const InputActionInstance& instance)
+    {
+        const ActionBindingData& binding = m_actionBindings[action];
+        if (binding.m_callback)
+        {
+            bool shouldCallback = false;
+
+            switch (instance.m_triggerState)
+            {
+            case TriggerState::Started:
+                shouldCallback = HasFlag(binding.m_events, TriggerEvent::Started);
+                break;
+            case TriggerState::Ongoing:
+                shouldCallback = HasFlag(binding.m_events, TriggerEvent::Ongoing);
+                break;
+            case TriggerState::Triggered:
+                shouldCallback = HasFlag(binding.m_events, TriggerEvent::Triggered);
+                break;
+            case TriggerState::Completed:
+                shouldCallback = HasFlag(binding.m_events, TriggerEvent::Completed);
+                break;
+            case TriggerState::Canceled:
+                shouldCallback = HasFlag(binding.m_events, TriggerEvent::Canceled);
+                break;
+            default:
+                break;
+            }
+
+            if (shouldCallback)
+            {
+                binding.m_callback(instance);
+            }
+        }
+
+        switch (instance.m_triggerState)
+        {
+        case TriggerState::Started:
+            EnhancedInputNotificationBus::Broadcast(&EnhancedInputNotifications::OnActionStarted, instance);
+            break;
+        case TriggerState::Ongoing:
+            EnhancedInputNotificationBus::Broadcast(&EnhancedInputNotifications::OnActionOngoing, instance);
+            break;
+        case TriggerState::Triggered:
+            EnhancedInputNotificationBus::Broadcast(&EnhancedInputNotifications::OnActionTriggered, instance);
+            break;
+        case TriggerState::Completed:
+            EnhancedInputNotificationBus::Broadcast(&EnhancedInputNotifications::OnActionCompleted, instance);
+            break;
+        case TriggerState::Canceled:
+            EnhancedInputNotificationBus::Broadcast(&EnhancedInputNotifications::OnActionCanceled, instance);
+            break;
+        default:
+            break;
+        }
+    }
+
+    AZ::Vector3 EnhancedInputSystemComponent::ApplyModifiers(const InputValue& value, const DispatchEntry& entry) const
+    {
+        return RunModifierProgram(m_modifierOps.data() + entry.m_firstModifierOp, entry.m_modifierOpCount, value);
     }
 
 } // namespace EnhancedInput
@@ -10,13 +10,21 @@
 
 #include <AzCore/Component/Component.h>
 #include <AzCore/Component/TickBus.h>
-#include <AzCore/std/containers/map.h>
-#include <AzCore/std/containers/set.h>
+#include <AzCore/std/containers/deque.h>
 #include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzCore/std/parallel/atomic.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/parallel/thread.h>
 #include <AzCore/Math/Crc.h>
 #include <AzFramework/Input/Events/InputChannelEventListener.h>
 #include <EnhancedInput/EnhancedInputBus.h>
 
+#include "InputPipeline.h"
+#include "InputRecording.h"
+#include "SpscQueue.h"
+#include "VirtualControllerBatch.h"
+
 namespace EnhancedInput
 {
     struct ActionBindingData
@@ -25,11 +33,70 @@ namespace EnhancedInput
         InputActionCallback m_callback;
     };
 
-    struct ActionRuntimeState
+    struct DispatchEntry
+    {
+        ActionHandle m_action = InvalidActionHandle;
+        ChannelIndex m_channel = InvalidChannelIndex;
+        //! The binding's triggers and their runtime states occupy m_triggerCount consecutive slots from here.
+        //! Entries hold no pointer into their context, so the index stays safe to evaluate while contexts are edited.
+        AZ::u32 m_firstTriggerSlot = 0;
+        AZ::u32 m_triggerCount = 0;
+        //! The binding's modifier chain, compiled to m_modifierOpCount ops of the system's op array from here.
+        AZ::u32 m_firstModifierOp = 0;
+        AZ::u32 m_modifierOpCount = 0;
+    };
+
+    struct DispatchRange
+    {
+        AZ::u32 m_first = 0;
+        AZ::u32 m_count = 0;
+    };
+
+    struct CompiledContextRevision
+    {
+        //! Held until the next rebuild, so no other context can take its address while its bindings are still compiled.
+        InputMappingContextPtr m_context;
+        AZ::u32 m_revision = 0;
+        //! The context's compiled bindings occupy m_bindingCount consecutive CompiledBinding records from here.
+        AZ::u32 m_firstBinding = 0;
+        AZ::u32 m_bindingCount = 0;
+    };
+
+    //! Identifies a compiled binding within its context, in binding order, and where its trigger states live.
+    struct CompiledBinding
+    {
+        AZ::u32 m_bindingIndex = 0;
+        AZ::u32 m_bindingId = 0;
+        AZ::u32 m_firstTriggerSlot = 0;
+        AZ::u32 m_triggerCount = 0;
+    };
+
+    enum class ContextChangeType : AZ::u8
+    {
+        Add,
+        Remove,
+        Clear
+    };
+
+    struct ContextChange
+    {
+        ContextChangeType m_type = ContextChangeType::Add;
+        ActiveMappingContext m_context;
+        AZStd::string m_contextName;
+    };
+
+    //! A channel event handed to the sampling thread, tagged with the local user of the device that produced it.
+    struct SampledInputEvent
+    {
+        AzFramework::LocalUserId m_localUserId = AzFramework::LocalUserIdAny;
+        InputEvent m_event;
+    };
+
+    struct ComboDefinition
     {
-        InputActionInstance m_instance;
-        AZStd::vector<InputTriggerPtr> m_activeTriggers;
-        InputValue m_accumulatedValue;
+        AZStd::string m_name;
+        AZStd::vector<AZStd::string> m_steps;
+        float m_maxStepInterval = 0.0f;
     };
 
     class EnhancedInputSystemComponent
@@ -52,18 +119,68 @@ namespace EnhancedInput
         ~EnhancedInputSystemComponent();
 
     protected:
-        void RegisterAction(const AZStd::string& name, InputValueType valueType = InputValueType::Boolean) override;
+        ActionHandle RegisterAction(const AZStd::string& name, InputValueType valueType = InputValueType::Boolean) override;
         void UnregisterAction(const AZStd::string& name) override;
         const InputAction* GetAction(const AZStd::string& name) const override;
+        ActionHandle GetActionHandle(const AZStd::string& name) const override;
+        void SetActionConsumesInput(ActionHandle action, bool consume) override;
 
         void AddMappingContext(InputMappingContextPtr context, int priority = 0) override;
         void RemoveMappingContext(const AZStd::string& contextName) override;
         void ClearMappingContexts() override;
+        void BeginContextChanges() override;
+        void CommitContextChanges() override;
 
         void BindAction(const AZStd::string& actionName, TriggerEvent events, InputActionCallback callback) override;
+        void BindAction(ActionHandle action, TriggerEvent events, InputActionCallback callback) override;
         void UnbindAction(const AZStd::string& actionName) override;
 
         const InputActionInstance* GetActionState(const AZStd::string& actionName) const override;
+        const InputActionInstance* GetActionState(ActionHandle action) const override;
+        InputValue GetLateLatchedActionValue(ActionHandle action) override;
+        AZ::u32 GetFixedStepCount() const override;
+        InputValue GetFixedStepActionValue(ActionHandle action, AZ::u32 step) const override;
+        AZ::u32 GetFixedStepCount(AzFramework::LocalUserId localUserId) const override;
+        InputValue GetFixedStepActionValue(AzFramework::LocalUserId localUserId, ActionHandle action, AZ::u32 step) const override;
+
+        void SetActionHistoryCapacity(ActionHandle action, AZ::u32 capacity) override;
+        bool WasTriggeredWithin(ActionHandle action, float seconds) const override;
+        float TimeSinceLastState(ActionHandle action, TriggerState state) const override;
+        bool ConsumeBuffered(ActionHandle action, float seconds) override;
+        bool WasTriggeredWithin(AzFramework::LocalUserId localUserId, ActionHandle action, float seconds) const override;
+        float TimeSinceLastState(AzFramework::LocalUserId localUserId, ActionHandle action, TriggerState state) const override;
+        bool ConsumeBuffered(AzFramework::LocalUserId localUserId, ActionHandle action, float seconds) override;
+
+        ActionHandle RegisterCombo(const AZStd::string& comboName, const AZStd::vector<AZStd::string>& sequence, float maxStepInterval) override;
+
+        void AddLocalUser(AzFramework::LocalUserId localUserId) override;
+        void RemoveLocalUser(AzFramework::LocalUserId localUserId) override;
+        const InputActionInstance* GetLocalUserActionState(AzFramework::LocalUserId localUserId, ActionHandle action) const override;
+
+        void SetVirtualControllerCount(AZ::u32 count) override;
+        float* GetVirtualChannelValues(const AzFramework::InputChannelId& channelId) override;
+        InputValue* GetVirtualActionValues(ActionHandle action) override;
+        void EvaluateVirtualControllers(float deltaTime) override;
+        InputValue GetVirtualActionValue(AZ::u32 controller, ActionHandle action) const override;
+        TriggerState GetVirtualActionState(AZ::u32 controller, ActionHandle action) const override;
+
+        void AddRemoteClient(AZ::u32 clientId) override;
+        void RemoveRemoteClient(AZ::u32 clientId) override;
+        void EvaluateRemoteFrames(const AZStd::vector<RemoteInputFrame>& frames, const AZStd::vector<RemoteInputEvent>& events) override;
+        const InputActionInstance* GetRemoteClientActionState(AZ::u32 clientId, ActionHandle action) const override;
+
+        bool StartInputRecording(const AZStd::string& path) override;
+        void StopInputRecording() override;
+        bool StartInputReplay(const AZStd::string& path) override;
+        void StopInputReplay() override;
+        bool IsReplayingInput() const override;
+
+        void GetActionValueTypes(AZStd::vector<InputValueType>& valueTypes) const override;
+        void CopyActionStates(
+            AzFramework::LocalUserId localUserId, AZStd::vector<InputValue>& values, AZStd::vector<TriggerState>& triggerStates) const override;
+
+        void SaveState(AzFramework::LocalUserId localUserId, AZStd::vector<AZ::u8>& state) const override;
+        bool RestoreState(AzFramework::LocalUserId localUserId, const AZStd::vector<AZ::u8>& state) override;
 
         void Init() override;
         void Activate() override;
@@ -74,16 +191,167 @@ namespace EnhancedInput
         bool OnInputChannelEventFiltered(const AzFramework::InputChannel& inputChannel) override;
 
     private:
-        void ProcessInputForAction(const AZStd::string& actionName, const InputValue& rawValue, float deltaTime);
-        void NotifyActionState(const AZStd::string& actionName, const InputActionInstance& instance);
-        InputValue ApplyModifiers(const InputValue& value, const AZStd::vector<InputModifierPtr>& modifiers) const;
-        TriggerState EvaluateTriggers(const InputValue& value, AZStd::vector<InputTriggerPtr>& triggers, float deltaTime) const;
-
-        AZStd::map<AZStd::string, InputAction> m_registeredActions;
-        AZStd::set<ActiveMappingContext> m_activeContexts;
-        AZStd::map<AZStd::string, ActionBindingData> m_actionBindings;
-        AZStd::map<AZStd::string, ActionRuntimeState> m_actionStates;
-        AZStd::unordered_map<AZ::Crc32, InputValue> m_pendingInputs;
+        void NotifyActionState(ActionHandle action, const InputActionInstance& instance);
+        AZ::Vector3 ApplyModifiers(const InputValue& value, const DispatchEntry& entry) const;
+        bool IsRegistered(ActionHandle action) const;
+        //! Whether a combo is named so or has a step named so, i.e. whether (un)registering the action changes the combos.
+        bool IsComboAction(const AZStd::string& name) const;
+
+        InputPipeline& GetDefaultPipeline() const { return *m_pipelines.front(); }
+        InputPipeline* FindPipeline(AzFramework::LocalUserId localUserId) const;
+        InputPipeline& RoutePipeline(AzFramework::LocalUserId localUserId) const;
+        void ResetPipelines();
+        void UpdateCompiledData();
+        template<typename Function>
+        void ForEachPipeline(Function&& function)
+        {
+            for (const auto& pipeline : m_pipelines)
+            {
+                function(*pipeline);
+            }
+            for (const auto& pipeline : m_remoteClients)
+            {
+                function(*pipeline);
+            }
+        }
+        void SizePipeline(InputPipeline& pipeline) const;
+        const InputActionInstance* GetActionState(const InputPipeline& pipeline, ActionHandle action) const;
+        float TimeSinceLastState(const InputPipeline& pipeline, ActionHandle action, TriggerState state) const;
+        bool ConsumeBuffered(InputPipeline& pipeline, ActionHandle action, float seconds);
+        InputValue GetFixedStepActionValue(const InputPipeline& pipeline, ActionHandle action, AZ::u32 step) const;
+        void DestroyRetiredPipelines();
+
+        void MarkActionDirty(InputPipeline& pipeline, ActionHandle action);
+        bool ShouldStayDirty(const InputPipeline& pipeline, ActionHandle action) const;
+        void QueueInputEvent(InputPipeline& pipeline, const InputEvent& event);
+        float GetLatestChannelValue(const InputPipeline& pipeline, ChannelIndex channel) const;
+        void DrainSampledEvents();
+        void HandleChannelEvent(AZ::Crc32 channelCrc, AzFramework::LocalUserId localUserId, float value, AZStd::sys_time_t timeUs);
+        void ReplayRecordedTick(float& deltaTime, AZStd::sys_time_t& nowUs);
+        void EvaluatePipeline(InputPipeline& pipeline, float deltaTime, AZStd::sys_time_t nowUs);
+        void EvaluatePipelinesInParallel(float deltaTime, AZStd::sys_time_t nowUs);
+        void DeliverDeferredNotifications(InputPipeline& pipeline);
+        void EvaluateActions(InputPipeline& pipeline, float deltaTime, AZStd::sys_time_t frameEndUs);
+        void RunFixedSteps(InputPipeline& pipeline, float deltaTime, AZStd::sys_time_t nowUs);
+        void ReplayInputEvents(InputPipeline& pipeline, AZStd::sys_time_t frameStartUs, AZStd::sys_time_t frameEndUs);
+        void UpdateAction(InputPipeline& pipeline, ActionHandle action, float deltaTime);
+        void PublishActionState(InputPipeline& pipeline, ActionHandle action);
+        void OnActionActivated(InputPipeline& pipeline, ActionHandle action);
+        void FireCombo(InputPipeline& pipeline, ActionHandle combo);
+
+        void StartSamplingThread();
+        void StopSamplingThread();
+        void RunSamplingThread();
+        void DeliverSampledStates();
+
+        void ApplyContextChanges();
+        void RebuildDispatchIndex();
+        bool IsDispatchIndexStale() const;
+        void RebuildComboAutomaton();
+        void SizeVirtualControllers();
+        void EvaluateVirtualAction(ActionHandle action, float deltaTime);
+
+        // Per-action data is indexed by ActionHandle. Actions live in a deque so InputActionInstance::m_action stays valid as more are registered.
+        AZStd::deque<InputAction> m_registeredActions;
+        AZStd::vector<ActionBindingData> m_actionBindings;
+        // History capacity given to newly registered actions.
+        AZ::u32 m_defaultHistoryCapacity = 0;
+        // When set, actions at rest are skipped entirely by the tick instead of being re-evaluated.
+        bool m_incrementalTick = true;
+        // Reports any allocation by the gem's runtime containers while actions are evaluated, which should be allocation
+        // free once warmed up. Only RuntimeAllocator containers are tracked; see AllocationTrackingScope.
+        bool m_trackTickAllocations = false;
+        // Trigger timers count integer microseconds between event and evaluation timestamps instead of summing float
+        // frame times, and every queued event is evaluated at its own time, so results do not depend on frame slicing.
+        bool m_deterministicTiming = false;
+        AZStd::vector<ActionHandle> m_freeActionHandles;
+        AZStd::unordered_map<AZStd::string, ActionHandle> m_actionHandles;
+        // Callbacks bound by name before the action was registered.
+        AZStd::unordered_map<AZStd::string, ActionBindingData> m_pendingActionBindings;
+
+        // Runtime state per local user. The first pipeline is the default one: it serves every device whose user has
+        // no pipeline of their own, and all queries that do not name a user. Pipelines are heap allocated so growing
+        // the list never moves one while it is being evaluated, and removed users are only retired until the next tick.
+        AZStd::vector<AZStd::unique_ptr<InputPipeline>> m_pipelines;
+        // Opt-in: once at least this many pipelines are active they are evaluated as jobs, which needs a job manager.
+        // Notifications and callbacks are then delivered only after every pipeline has been evaluated, pipeline by
+        // pipeline, instead of as each action changes; a callback sees the end-of-tick state of all users.
+        // 0 keeps every pipeline on the game thread with immediate notifications.
+        AZ::u32 m_minParallelPipelines = 0;
+        AZStd::vector<InputPipeline*> m_parallelPipelines;
+        // Arguments of the tick being evaluated in parallel, read by the pipelines' reusable evaluation jobs.
+        float m_parallelDeltaTime = 0.0f;
+        AZStd::sys_time_t m_parallelNowUs = 0;
+
+        // Headless pipelines of remote clients on a server, evaluated only by EvaluateRemoteFrames.
+        AZStd::vector<AZStd::unique_ptr<InputPipeline>> m_remoteClients;
+        AZStd::unordered_map<AZ::u32, size_t> m_remoteClientIndices;
+
+        // Ordered by descending priority; contexts of equal priority keep the order they were added in.
+        AZStd::vector<ActiveMappingContext> m_activeContexts;
+        AZStd::vector<ContextChange> m_pendingContextChanges;
+        AZ::u32 m_contextChangeDepth = 0;
+        ChannelIndexMap m_channelIndices;
+
+        // When positive, OnTick evaluates whole steps of this many seconds instead of one variable frame, each step
+        // consuming only the events timestamped within it. Matches the physics fixed timestep when set to the same value.
+        float m_fixedTimestep = 0.0f;
+        AZ::u32 m_maxFixedSteps = 8;
+
+        // Channel index -> the bindings it feeds, used to find the actions a changed channel dirties.
+        // Action handle -> its bindings, used to re-accumulate a dirty action from current channel state.
+        // Both are ordered by context priority and rebuilt only when the active contexts, their bindings or the registered actions change.
+        AZStd::vector<DispatchRange> m_channelDispatch;
+        AZStd::vector<DispatchEntry> m_channelEntries;
+        AZStd::vector<DispatchRange> m_actionDispatch;
+        AZStd::vector<DispatchEntry> m_actionEntries;
+        AZStd::vector<CompiledContextRevision> m_compiledRevisions;
+        AZStd::vector<CompiledBinding> m_compiledBindings;
+        // The previous compilation, kept by a rebuild to carry trigger states over. Empty otherwise.
+        AZStd::vector<CompiledContextRevision> m_previousRevisions;
+        AZStd::vector<CompiledBinding> m_previousBindings;
+        // Trigger slots laid out by the index; each pipeline holds this many runtime states, so the triggers held by shared contexts stay immutable.
+        AZ::u32 m_triggerSlotCount = 0;
+        // The trigger of every slot, shared with the binding it was compiled from.
+        AZStd::vector<InputTriggerPtr> m_compiledTriggers;
+        // Compiled modifier chains of all dispatch entries, rebuilt with the dispatch index.
+        AZStd::vector<ModifierOp> m_modifierOps;
+        bool m_dispatchDirty = true;
+
+        // Combos are kept by action name and compiled into one automaton whenever combos or the actions they name change.
+        // Rebuilding restarts every pipeline's match, so unrelated actions leave it alone. It advances only when an action
+        // it knows activates, so its cost follows input activity rather than the number of combos.
+        AZStd::vector<ComboDefinition> m_comboDefinitions;
+        ComboAutomaton m_comboAutomaton;
+        bool m_combosDirty = false;
+
+        // Shares the compiled dispatch index; trigger states of bindings that stay compiled survive a rebuild, as in pipelines.
+        VirtualControllerBatch m_virtualControllers;
+
+        // Device events and ticks are recorded before anything else sees them, and replayed through the same path.
+        InputRecordWriter m_inputRecorder;
+        InputRecordReader m_inputReplay;
+        bool m_isReplayingInput = false;
+
+        // Optional dedicated thread that evaluates modifiers and triggers at m_samplingRateHz instead of once per game tick.
+        // Channel events reach it and state changes come back through SPSC queues, so device input and notification
+        // delivery never wait for it; callbacks and notifications are still delivered on the game thread from OnTick.
+        // Each sample is evaluated under m_pipelineMutex, so game thread queries do wait for a sample in progress.
+        // Not started when m_fixedTimestep or m_minParallelPipelines is set, since those modes evaluate from the tick.
+        bool m_useSamplingThread = false;
+        AZ::u32 m_samplingRateHz = 1000;
+        AZStd::thread m_samplingThread;
+        AZStd::atomic_bool m_isSamplingThreadRunning{ false };
+        // Produced by the device listener. Consumed by whichever thread holds m_pipelineMutex, the sampling thread or
+        // a game thread path that needs the newest events; the lock is what keeps it to one consumer at a time.
+        SpscQueue<SampledInputEvent, 1024> m_sampledEvents;
+        SpscQueue<SampledActionState, 1024> m_sampledStates;
+        // State changes that did not fit into m_sampledStates, retried in order on the next sample. Sampling thread only.
+        RuntimeVector<SampledActionState> m_unsentSampledStates;
+        // Held by the sampling thread for each sample, and by the game thread whenever it touches pipeline state
+        // or the compiled dispatch index. The sampling thread reads nothing else, so mapping contexts may still be
+        // edited on the game thread without it. Recursive so callbacks may call back into the request bus.
+        mutable AZStd::recursive_mutex m_pipelineMutex;
     };
 
 } // namespace EnhancedInput
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "ComboAutomaton.h"
+
+#include <AzCore/std/containers/queue.h>
+
+namespace EnhancedInput
+{
+    void ComboAutomaton::Clear()
+    {
+        m_symbols.clear();
+        m_symbolCount = 0;
+        m_transitions.clear();
+        m_outputRanges.clear();
+        m_outputs.clear();
+        m_combos.clear();
+        m_maxLength = 0;
+    }
+
+    void ComboAutomaton::Build(const AZStd::vector<ComboSequence>& sequences, size_t actionCount)
+    {
+        Clear();
+        m_symbols.resize(actionCount, InvalidIndex);
+
+        for (const ComboSequence& sequence : sequences)
+        {
+            for (const ActionHandle step : sequence.m_steps)
+            {
+                if (m_symbols[step] == InvalidIndex)
+                {
+                    m_symbols[step] = m_symbolCount++;
+                }
+            }
+        }
+
+        if (m_symbolCount == 0)
+        {
+            return;
+        }
+
+        // Trie of all sequences, node 0 being the root.
+        AZStd::vector<AZStd::vector<AZ::u32>> nodeOutputs(1);
+        m_transitions.resize(m_symbolCount, InvalidIndex);
+
+        for (const ComboSequence& sequence : sequences)
+        {
+            if (sequence.m_steps.empty())
+            {
+                continue;
+            }
+
+            AZ::u32 node = 0;
+            for (const ActionHandle step : sequence.m_steps)
+            {
+                const size_t transition = node * m_symbolCount + m_symbols[step];
+                if (m_transitions[transition] == InvalidIndex)
+                {
+                    m_transitions[transition] = static_cast<AZ::u32>(nodeOutputs.size());
+                    nodeOutputs.emplace_back();
+                    m_transitions.resize(m_transitions.size() + m_symbolCount, InvalidIndex);
+                }
+                node = m_transitions[transition];
+            }
+
+            const AZ::u32 length = static_cast<AZ::u32>(sequence.m_steps.size());
+            nodeOutputs[node].push_back(static_cast<AZ::u32>(m_combos.size()));
+            m_combos.push_back({ sequence.m_combo, length, sequence.m_maxStepIntervalUs });
+            m_maxLength = AZ::GetMax(m_maxLength, length);
+        }
+
+        // Breadth-first pass computing failure links and folding them into the transition table, so advancing never
+        // walks a chain. A failure target is always shallower than its node and therefore already complete.
+        AZStd::vector<AZ::u32> failure(nodeOutputs.size(), 0);
+        AZStd::queue<AZ::u32> pending;
+        for (AZ::u32 symbol = 0; symbol < m_symbolCount; ++symbol)
+        {
+            if (m_transitions[symbol] == InvalidIndex)
+            {
+                m_transitions[symbol] = 0;
+            }
+            else
+            {
+                pending.push(m_transitions[symbol]);
+            }
+        }
+
+        while (!pending.empty())
+        {
+            const AZ::u32 node = pending.front();
+            pending.pop();
+
+            for (AZ::u32 symbol = 0; symbol < m_symbolCount; ++symbol)
+            {
+                const size_t transition = node * m_symbolCount + symbol;
+                const AZ::u32 fallback = m_transitions[failure[node] * m_symbolCount + symbol];
+                if (m_transitions[transition] == InvalidIndex)
+                {
+                    m_transitions[transition] = fallback;
+                    continue;
+                }
+
+                const AZ::u32 next = m_transitions[transition];
+                failure[next] = fallback;
+                nodeOutputs[next].insert(nodeOutputs[next].end(), nodeOutputs[fallback].begin(), nodeOutputs[fallback].end());
+                pending.push(next);
+            }
+        }
+
+        m_outputRanges.resize(nodeOutputs.size());
+        for (size_t node = 0; node < nodeOutputs.size(); ++node)
+        {
+            m_outputRanges[node].m_first = static_cast<AZ::u32>(m_outputs.size());
+            m_outputRanges[node].m_count = static_cast<AZ::u32>(nodeOutputs[node].size());
+            m_outputs.insert(m_outputs.end(), nodeOutputs[node].begin(), nodeOutputs[node].end());
+        }
+    }
+
+    void ComboAutomaton::ResetState(ComboMatchState& state) const
+    {
+        state.m_node = 0;
+        state.m_activationTimes.resize(m_maxLength);
+        state.m_activationHead = 0;
+        state.m_activationCount = 0;
+    }
+
+    void ComboAutomaton::Advance(
+        ComboMatchState& state, ActionHandle action, AZStd::sys_time_t timeUs, RuntimeVector<ActionHandle>& completedCombos) const
+    {
+        if (action >= m_symbols.size() || m_symbols[action] == InvalidIndex || state.m_activationTimes.empty())
+        {
+            return;
+        }
+
+        const AZ::u32 capacity = static_cast<AZ::u32>(state.m_activationTimes.size());
+        if (state.m_activationCount == capacity)
+        {
+            state.m_activationHead = (state.m_activationHead + 1) % capacity;
+            --state.m_activationCount;
+        }
+        state.m_activationTimes[(state.m_activationHead + state.m_activationCount) % capacity] = timeUs;
+        ++state.m_activationCount;
+
+        state.m_node = m_transitions[state.m_node * m_symbolCount + m_symbols[action]];
+
+        const OutputRange& outputs = m_outputRanges[state.m_node];
+        AZ::u32 completedLength = 0;
+        for (AZ::u32 output = outputs.m_first; output < outputs.m_first + outputs.m_count; ++output)
+        {
+            const CompiledCombo& combo = m_combos[m_outputs[output]];
+            if (combo.m_length < completedLength)
+            {
+                break;
+            }
+
+            if (IsTimingValid(state, combo))
+            {
+                completedCombos.push_back(combo.m_combo);
+                completedLength = combo.m_length;
+            }
+        }
+
+        if (completedLength > 0)
+        {
+            state.m_node = 0;
+            state.m_activationHead = 0;
+            state.m_activationCount = 0;
+        }
+    }
+
+    bool ComboAutomaton::IsTimingValid(const ComboMatchState& state, const CompiledCombo& combo) const
+    {
+        if (state.m_activationCount < combo.m_length)
+        {
+            return false;
+        }
+
+        const AZ::u32 capacity = static_cast<AZ::u32>(state.m_activationTimes.size());
+        const AZ::u32 newest = state.m_activationHead + state.m_activationCount - 1;
+        for (AZ::u32 step = 1; step < combo.m_length; ++step)
+        {
+            const AZStd::sys_time_t later = state.m_activationTimes[(newest - step + 1) % capacity];
+            const AZStd::sys_time_t earlier = state.m_activationTimes[(newest - step) % capacity];
+            if (later - earlier > combo.m_maxStepIntervalUs)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace EnhancedInput
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/time.h>
+#include <EnhancedInput/InputAction.h>
+
+#include "AllocationTracker.h"
+
+namespace EnhancedInput
+{
+    struct ComboSequence
+    {
+        ActionHandle m_combo = InvalidActionHandle;
+        AZStd::vector<ActionHandle> m_steps;
+        AZStd::sys_time_t m_maxStepIntervalUs = 0;
+    };
+
+    //! Where one evaluator is within the combo automaton, plus the times of its most recent activations.
+    struct ComboMatchState
+    {
+        AZ::u32 m_node = 0;
+        RuntimeVector<AZStd::sys_time_t> m_activationTimes;
+        AZ::u32 m_activationHead = 0;
+        AZ::u32 m_activationCount = 0;
+    };
+
+    //! Every registered combo compiled into a single Aho-Corasick automaton over action activations. Each activation
+    //! is one table lookup whatever the number of combos, and the combos ending at it are read from the reached node.
+    //! Immutable once built, so several evaluators can share it, each with its own ComboMatchState.
+    class ComboAutomaton
+    {
+    public:
+        void Build(const AZStd::vector<ComboSequence>& sequences, size_t actionCount);
+        void Clear();
+
+        bool IsEmpty() const { return m_combos.empty(); }
+        size_t GetComboCount() const { return m_combos.size(); }
+
+        //! Sizes a match state for this automaton and puts it back at the root.
+        void ResetState(ComboMatchState& state) const;
+
+        //! Feeds one activation of an action. Appends the combo actions completed by it to completedCombos; when several
+        //! combos end here only the longest ones whose timing holds are reported, and matching starts over after them.
+        void Advance(ComboMatchState& state, ActionHandle action, AZStd::sys_time_t timeUs, RuntimeVector<ActionHandle>& completedCombos) const;
+
+    private:
+        static constexpr AZ::u32 InvalidIndex = static_cast<AZ::u32>(-1);
+
+        struct CompiledCombo
+        {
+            ActionHandle m_combo = InvalidActionHandle;
+            AZ::u32 m_length = 0;
+            AZStd::sys_time_t m_maxStepIntervalUs = 0;
+        };
+
+        struct OutputRange
+        {
+            AZ::u32 m_first = 0;
+            AZ::u32 m_count = 0;
+        };
+
+        bool IsTimingValid(const ComboMatchState& state, const CompiledCombo& combo) const;
+
+        // Action handle -> symbol, InvalidIndex for actions no combo uses.
+        AZStd::vector<AZ::u32> m_symbols;
+        AZ::u32 m_symbolCount = 0;
+        // Node * m_symbolCount + symbol -> next node, failure links already folded in.
+        AZStd::vector<AZ::u32> m_transitions;
+        // Combos ending at each node, longest first, including those inherited through failure links.
+        AZStd::vector<OutputRange> m_outputRanges;
+        AZStd::vector<AZ::u32> m_outputs;
+        AZStd::vector<CompiledCombo> m_combos;
+        AZ::u32 m_maxLength = 0;
+    };
+
+} // namespace EnhancedInput
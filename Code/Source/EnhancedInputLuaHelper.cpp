@@ -14,6 +14,18 @@
 
 namespace EnhancedInput
 {
+    namespace
+    {
+        const InputActionInstance* FindActionState(const AZStd::string& actionName)
+        {
+            using GetActionStateByName = const InputActionInstance* (EnhancedInputRequests::*)(const AZStd::string&) const;
+
+            const InputActionInstance* state = nullptr;
+            EnhancedInputRequestBus::BroadcastResult(state, static_cast<GetActionStateByName>(&EnhancedInputRequests::GetActionState), actionName);
+            return state;
+        }
+    } // namespace
+
     InputMappingContextPtr EnhancedInputLuaHelper::CreateContext(const AZStd::string& name)
     {
         return AZStd::make_shared<InputMappingContext>(name);
@@ -120,8 +132,7 @@ namespace EnhancedInput
 
     float EnhancedInputLuaHelper::GetActionValue(const AZStd::string& actionName)
     {
-        const InputActionInstance* state = nullptr;
-        EnhancedInputRequestBus::BroadcastResult(state, &EnhancedInputRequests::GetActionState, actionName);
+        const InputActionInstance* state = FindActionState(actionName);
         if (state)
         {
             return state->m_value.GetAxis1D();
@@ -131,8 +142,7 @@ namespace EnhancedInput
 
     float EnhancedInputLuaHelper::GetActionValueX(const AZStd::string& actionName)
     {
-        const InputActionInstance* state = nullptr;
-        EnhancedInputRequestBus::BroadcastResult(state, &EnhancedInputRequests::GetActionState, actionName);
+        const InputActionInstance* state = FindActionState(actionName);
         if (state)
         {
             return state->m_value.GetAxis3D().GetX();
@@ -142,8 +152,7 @@ namespace EnhancedInput
 
     float EnhancedInputLuaHelper::GetActionValueY(const AZStd::string& actionName)
     {
-        const InputActionInstance* state = nullptr;
-        EnhancedInputRequestBus::BroadcastResult(state, &EnhancedInputRequests::GetActionState, actionName);
+        const InputActionInstance* state = FindActionState(actionName);
         if (state)
         {
             return state->m_value.GetAxis3D().GetY();
@@ -153,8 +162,7 @@ namespace EnhancedInput
 
     float EnhancedInputLuaHelper::GetActionValueZ(const AZStd::string& actionName)
     {
-        const InputActionInstance* state = nullptr;
-        EnhancedInputRequestBus::BroadcastResult(state, &EnhancedInputRequests::GetActionState, actionName);
+        const InputActionInstance* state = FindActionState(actionName);
         if (state)
         {
             return state->m_value.GetAxis3D().GetZ();
@@ -164,8 +172,7 @@ namespace EnhancedInput
 
     bool EnhancedInputLuaHelper::IsActionTriggered(const AZStd::string& actionName)
     {
-        const InputActionInstance* state = nullptr;
-        EnhancedInputRequestBus::BroadcastResult(state, &EnhancedInputRequests::GetActionState, actionName);
+        const InputActionInstance* state = FindActionState(actionName);
         if (state)
         {
             return state->IsTriggered();
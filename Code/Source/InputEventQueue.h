@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/time.h>
+
+#include "ChannelStateTable.h"
+
+namespace EnhancedInput
+{
+    struct InputEvent
+    {
+        AZStd::sys_time_t m_timeUs = 0;
+        ChannelIndex m_channel = InvalidChannelIndex;
+        float m_value = 0.0f;
+    };
+
+    //! Fixed-capacity ring buffer of timestamped channel events received between two ticks.
+    //! Never allocates; when full, the oldest event is handed back to the caller so it can be applied immediately.
+    class InputEventQueue
+    {
+    public:
+        static constexpr AZ::u32 Capacity = 256;
+
+        bool IsEmpty() const { return m_count == 0; }
+        AZ::u32 GetSize() const { return m_count; }
+
+        //! Returns true and fills evicted if the queue was full and its oldest event had to make room.
+        bool Push(const InputEvent& event, InputEvent& evicted)
+        {
+            bool didEvict = false;
+            if (m_count == Capacity)
+            {
+                evicted = m_events[m_head];
+                m_head = (m_head + 1) % Capacity;
+                --m_count;
+                didEvict = true;
+            }
+
+            m_events[(m_head + m_count) % Capacity] = event;
+            ++m_count;
+            return didEvict;
+        }
+
+        //! Drops the count oldest events.
+        void PopFront(AZ::u32 count)
+        {
+            count = count < m_count ? count : m_count;
+            m_head = (m_head + count) % Capacity;
+            m_count -= count;
+        }
+
+        //! Events in arrival order, index 0 being the oldest.
+        const InputEvent& operator[](AZ::u32 index) const { return m_events[(m_head + index) % Capacity]; }
+
+        void Clear()
+        {
+            m_head = 0;
+            m_count = 0;
+        }
+
+    private:
+        AZStd::array<InputEvent, Capacity> m_events;
+        AZ::u32 m_head = 0;
+        AZ::u32 m_count = 0;
+    };
+
+} // namespace EnhancedInput
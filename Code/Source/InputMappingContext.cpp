@@ -38,6 +38,8 @@ namespace EnhancedInput
     void InputMappingContext::AddBinding(const InputActionBinding& binding)
     {
         m_bindings.push_back(binding);
+        m_bindings.back().m_id = ++m_lastBindingId;
+        ++m_revision;
     }
 
     void InputMappingContext::RemoveBinding(const AZStd::string& actionName, const AzFramework::InputChannelId& channelId)
@@ -49,11 +51,13 @@ namespace EnhancedInput
                     return binding.m_actionName == actionName && binding.m_inputChannelId == channelId;
                 }),
             m_bindings.end());
+        ++m_revision;
     }
 
     void InputMappingContext::ClearBindings()
     {
         m_bindings.clear();
+        ++m_revision;
     }
 
     AZStd::vector<const InputActionBinding*> InputMappingContext::GetBindingsForChannel(const AzFramework::InputChannelId& channelId) const
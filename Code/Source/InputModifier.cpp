@@ -12,59 +12,185 @@
 
 namespace EnhancedInput
 {
-    void InputModifier::Reflect(AZ::ReflectContext* context)
+    namespace
     {
-        if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
-        {
-            serializeContext->Class<InputModifier>()
-                ->Version(1);
-        }
-    }
-
-    InputValue InputModifierDeadZone::ModifyValue(const InputValue& value) const
-    {
-        AZ::Vector3 data = value.GetAxis3D();
-
-        auto applyDeadZone = [this](float v) -> float
+        float ApplyAxialDeadZone(float v, float lowerThreshold, float upperThreshold)
         {
             float absVal = AZ::GetAbs(v);
-            if (absVal < m_lowerThreshold)
+            if (absVal < lowerThreshold)
             {
                 return 0.0f;
             }
-            if (absVal > m_upperThreshold)
+            if (absVal > upperThreshold)
             {
                 return v > 0.0f ? 1.0f : -1.0f;
             }
-            float normalized = (absVal - m_lowerThreshold) / (m_upperThreshold - m_lowerThreshold);
+
+            float normalized = (absVal - lowerThreshold) / (upperThreshold - lowerThreshold);
             return v > 0.0f ? normalized : -normalized;
-        };
+        }
 
-        if (m_type == DeadZoneType::Axial)
+        AZ::Vector3 ApplyAxialDeadZone(const AZ::Vector3& data, float lowerThreshold, float upperThreshold)
         {
-            data.SetX(applyDeadZone(data.GetX()));
-            data.SetY(applyDeadZone(data.GetY()));
-            data.SetZ(applyDeadZone(data.GetZ()));
+            return AZ::Vector3(
+                ApplyAxialDeadZone(data.GetX(), lowerThreshold, upperThreshold),
+                ApplyAxialDeadZone(data.GetY(), lowerThreshold, upperThreshold),
+                ApplyAxialDeadZone(data.GetZ(), lowerThreshold, upperThreshold));
         }
-        else
+
+        AZ::Vector3 ApplyRadialDeadZone(const AZ::Vector3& data, float lowerThreshold, float upperThreshold)
         {
             float length = data.GetLength();
-            if (length < m_lowerThreshold)
+            if (length < lowerThreshold)
             {
-                data = AZ::Vector3::CreateZero();
+                return AZ::Vector3::CreateZero();
             }
-            else if (length > m_upperThreshold)
+            if (length > upperThreshold)
             {
-                data = data.GetNormalized();
+                return data.GetNormalized();
             }
-            else
+
+            float normalized = (length - lowerThreshold) / (upperThreshold - lowerThreshold);
+            return data.GetNormalized() * normalized;
+        }
+
+        AZ::Vector3 ApplyClamp(const AZ::Vector3& data, float minValue, float maxValue)
+        {
+            return AZ::Vector3(
+                AZ::GetClamp(data.GetX(), minValue, maxValue),
+                AZ::GetClamp(data.GetY(), minValue, maxValue),
+                AZ::GetClamp(data.GetZ(), minValue, maxValue));
+        }
+
+        AZ::Vector3 ApplyNormalize(const AZ::Vector3& data)
+        {
+            return data.IsZero() ? data : data.GetNormalized();
+        }
+
+        bool IsIdentity(const AZ::Matrix3x3& matrix)
+        {
+            for (int row = 0; row < 3; ++row)
             {
-                float normalized = (length - m_lowerThreshold) / (m_upperThreshold - m_lowerThreshold);
-                data = data.GetNormalized() * normalized;
+                for (int column = 0; column < 3; ++column)
+                {
+                    if (matrix.GetElement(row, column) != (row == column ? 1.0f : 0.0f))
+                    {
+                        return false;
+                    }
+                }
             }
+            return true;
         }
+    } // namespace
 
-        return InputValue(data);
+    ModifierProgramBuilder::ModifierProgramBuilder(AZStd::vector<ModifierOp>& ops)
+        : m_ops(ops)
+        , m_firstOp(ops.size())
+    {
+    }
+
+    void ModifierProgramBuilder::AddChain(const AZStd::vector<InputModifierPtr>& modifiers)
+    {
+        for (const auto& modifier : modifiers)
+        {
+            if (modifier)
+            {
+                modifier->Compile(*this);
+            }
+        }
+    }
+
+    void ModifierProgramBuilder::AddLinear(const AZ::Matrix3x3& matrix)
+    {
+        if (m_ops.size() > m_firstOp && m_ops.back().m_code == ModifierOpCode::Linear)
+        {
+            // Applied after the previous one, so it multiplies from the left.
+            m_ops.back().m_matrix = matrix * m_ops.back().m_matrix;
+        }
+        else
+        {
+            ModifierOp& op = m_ops.emplace_back();
+            op.m_code = ModifierOpCode::Linear;
+            op.m_matrix = matrix;
+        }
+
+        if (IsIdentity(m_ops.back().m_matrix))
+        {
+            m_ops.pop_back();
+        }
+    }
+
+    void ModifierProgramBuilder::AddOp(ModifierOpCode code, float param0, float param1)
+    {
+        ModifierOp& op = m_ops.emplace_back();
+        op.m_code = code;
+        op.m_params[0] = param0;
+        op.m_params[1] = param1;
+    }
+
+    void ModifierProgramBuilder::AddCustom(const InputModifier* modifier)
+    {
+        ModifierOp& op = m_ops.emplace_back();
+        op.m_code = ModifierOpCode::Custom;
+        op.m_modifier = modifier;
+    }
+
+    AZ::Vector3 RunModifierProgram(const ModifierOp* ops, AZ::u32 opCount, const InputValue& value)
+    {
+        AZ::Vector3 data = value.GetAxis3D();
+        for (AZ::u32 index = 0; index < opCount; ++index)
+        {
+            const ModifierOp& op = ops[index];
+            switch (op.m_code)
+            {
+            case ModifierOpCode::Linear:
+                data = op.m_matrix * data;
+                break;
+            case ModifierOpCode::DeadZoneAxial:
+                data = ApplyAxialDeadZone(data, op.m_params[0], op.m_params[1]);
+                break;
+            case ModifierOpCode::DeadZoneRadial:
+                data = ApplyRadialDeadZone(data, op.m_params[0], op.m_params[1]);
+                break;
+            case ModifierOpCode::Clamp:
+                data = ApplyClamp(data, op.m_params[0], op.m_params[1]);
+                break;
+            case ModifierOpCode::Normalize:
+                data = ApplyNormalize(data);
+                break;
+            case ModifierOpCode::Custom:
+                // Only the first modifier of a chain sees the binding's own value type; later ones get Axis3D as before.
+                data = op.m_modifier->ModifyValue(index == 0 ? value : InputValue(data)).GetAxis3D();
+                break;
+            }
+        }
+        return data;
+    }
+
+    void InputModifier::Compile(ModifierProgramBuilder& builder) const
+    {
+        builder.AddCustom(this);
+    }
+
+    void InputModifier::Reflect(AZ::ReflectContext* context)
+    {
+        if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
+        {
+            serializeContext->Class<InputModifier>()
+                ->Version(1);
+        }
+    }
+
+    InputValue InputModifierDeadZone::ModifyValue(const InputValue& value) const
+    {
+        const AZ::Vector3 data = value.GetAxis3D();
+        return InputValue(m_type == DeadZoneType::Axial ? ApplyAxialDeadZone(data, m_lowerThreshold, m_upperThreshold)
+                                                        : ApplyRadialDeadZone(data, m_lowerThreshold, m_upperThreshold));
+    }
+
+    void InputModifierDeadZone::Compile(ModifierProgramBuilder& builder) const
+    {
+        builder.AddOp(m_type == DeadZoneType::Axial ? ModifierOpCode::DeadZoneAxial : ModifierOpCode::DeadZoneRadial, m_lowerThreshold, m_upperThreshold);
     }
 
     void InputModifierDeadZone::Reflect(AZ::ReflectContext* context)
@@ -102,6 +228,11 @@ namespace EnhancedInput
         return InputValue(data);
     }
 
+    void InputModifierNegate::Compile(ModifierProgramBuilder& builder) const
+    {
+        builder.AddLinear(AZ::Matrix3x3::CreateDiagonal(AZ::Vector3(m_negateX ? -1.0f : 1.0f, m_negateY ? -1.0f : 1.0f, m_negateZ ? -1.0f : 1.0f)));
+    }
+
     void InputModifierNegate::Reflect(AZ::ReflectContext* context)
     {
         if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
@@ -131,6 +262,16 @@ namespace EnhancedInput
         return InputValue(result);
     }
 
+    void InputModifierScale::Compile(ModifierProgramBuilder& builder) const
+    {
+        // Scales the X axis into all three, so the matrix only has a first column.
+        AZ::Matrix3x3 matrix = AZ::Matrix3x3::CreateZero();
+        matrix.SetElement(0, 0, m_scale.GetX());
+        matrix.SetElement(1, 0, m_scale.GetY());
+        matrix.SetElement(2, 0, m_scale.GetZ());
+        builder.AddLinear(matrix);
+    }
+
     void InputModifierScale::Reflect(AZ::ReflectContext* context)
     {
         if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
@@ -169,6 +310,19 @@ namespace EnhancedInput
         return InputValue(data);
     }
 
+    void InputModifierSwizzle::Compile(ModifierProgramBuilder& builder) const
+    {
+        // Row i selects the source axis of output axis i.
+        static constexpr AZ::u8 SourceAxes[][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+        const AZ::u8* sourceAxes = SourceAxes[static_cast<AZ::u8>(m_order)];
+        AZ::Matrix3x3 matrix = AZ::Matrix3x3::CreateZero();
+        for (int row = 0; row < 3; ++row)
+        {
+            matrix.SetElement(row, sourceAxes[row], 1.0f);
+        }
+        builder.AddLinear(matrix);
+    }
+
     void InputModifierSwizzle::Reflect(AZ::ReflectContext* context)
     {
         if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
@@ -189,11 +343,12 @@ namespace EnhancedInput
 
     InputValue InputModifierClamp::ModifyValue(const InputValue& value) const
     {
-        AZ::Vector3 data = value.GetAxis3D();
-        data.SetX(AZ::GetClamp(data.GetX(), m_min, m_max));
-        data.SetY(AZ::GetClamp(data.GetY(), m_min, m_max));
-        data.SetZ(AZ::GetClamp(data.GetZ(), m_min, m_max));
-        return InputValue(data);
+        return InputValue(ApplyClamp(value.GetAxis3D(), m_min, m_max));
+    }
+
+    void InputModifierClamp::Compile(ModifierProgramBuilder& builder) const
+    {
+        builder.AddOp(ModifierOpCode::Clamp, m_min, m_max);
     }
 
     void InputModifierClamp::Reflect(AZ::ReflectContext* context)
@@ -218,12 +373,12 @@ namespace EnhancedInput
 
     InputValue InputModifierNormalize::ModifyValue(const InputValue& value) const
     {
-        AZ::Vector3 data = value.GetAxis3D();
-        if (!data.IsZero())
-        {
-            data.Normalize();
-        }
-        return InputValue(data);
+        return InputValue(ApplyNormalize(value.GetAxis3D()));
+    }
+
+    void InputModifierNormalize::Compile(ModifierProgramBuilder& builder) const
+    {
+        builder.AddOp(ModifierOpCode::Normalize);
     }
 
     void InputModifierNormalize::Reflect(AZ::ReflectContext* context)
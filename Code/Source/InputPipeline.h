@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/Jobs/Job.h>
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzFramework/Input/User/LocalUserId.h>
+#include <EnhancedInput/InputTrigger.h>
+
+#include "ActionHistory.h"
+#include "ActionStateStorage.h"
+#include "ChannelStateTable.h"
+#include "ComboAutomaton.h"
+#include "InputEventQueue.h"
+
+namespace EnhancedInput
+{
+    //! An action state change produced off the game thread, waiting to be delivered on it.
+    struct SampledActionState
+    {
+        ActionHandle m_action = InvalidActionHandle;
+        InputActionInstance m_instance;
+    };
+
+    //! Everything that changes while one local user plays: channel values, action and trigger state, queued events and
+    //! histories. Registered actions, mapping contexts, the dispatch index and the combo automaton are compiled once by
+    //! the system component and shared, so an additional user costs only this state.
+    struct InputPipeline
+    {
+        AzFramework::LocalUserId m_localUserId = AzFramework::LocalUserIdAny;
+        // Remote client pipelines are evaluated headless and polled, so they publish no notifications.
+        bool m_isRemote = false;
+        // Set when the local user is removed. The pipeline is skipped from then on and destroyed at the start of the next
+        // tick, since it may be removed by a callback while it or another pipeline is being evaluated.
+        bool m_isRetired = false;
+
+        ChannelStateTable m_channelStates;
+        // Channel events since the last tick, replayed in order so several changes of one channel within a frame are not collapsed.
+        InputEventQueue m_inputEvents;
+        AZStd::array<bool, InputEventQueue::Capacity> m_isLastEventForChannel;
+        RuntimeVector<AZ::u64> m_replayedChannels;
+        AZStd::sys_time_t m_lastTickTimeUs = 0;
+        // Timestamp of the evaluation in progress, recorded into action histories.
+        AZStd::sys_time_t m_evaluationTimeUs = 0;
+
+        // Per-action data, indexed by ActionHandle.
+        ActionStateStorage m_actionStates;
+        AZStd::vector<ActionHistory> m_actionHistories;
+        // Materialized on demand by GetActionState, which has to hand out a stable pointer.
+        mutable AZStd::vector<InputActionInstance> m_actionInstances;
+        // Actions touched this tick: bound channels changed, a trigger timer is running, or they were not idle last tick.
+        RuntimeVector<ActionHandle> m_dirtyActions;
+        RuntimeVector<ActionHandle> m_tickingActions;
+
+        // One slot per trigger of every compiled binding, laid out by the shared dispatch index.
+        RuntimeVector<TriggerRuntimeState> m_triggerStates;
+
+        float m_fixedStepAccumulator = 0.0f;
+        AZ::u32 m_fixedStepCount = 0;
+        // Action values at the end of each step of the last tick, one row of action values per step.
+        RuntimeVector<InputValue> m_fixedStepValues;
+
+        ComboMatchState m_comboMatchState;
+        RuntimeVector<ActionHandle> m_completedCombos;
+        // A combo that fired keeps its Triggered state for the rest of the evaluation instead of being re-evaluated from bindings,
+        // and does not fire again until the next one.
+        RuntimeVector<AZ::u8> m_isComboFired;
+        RuntimeVector<ActionHandle> m_firedCombos;
+
+        // Set while the pipeline is evaluated by a job: state changes are collected here instead of being notified.
+        bool m_deferNotifications = false;
+        RuntimeVector<SampledActionState> m_deferredNotifications;
+        // Created on the first parallel tick and reset and restarted on each one after.
+        AZStd::unique_ptr<AZ::Job> m_evaluationJob;
+    };
+
+} // namespace EnhancedInput
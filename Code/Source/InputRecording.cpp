@@ -0,0 +1,471 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "InputRecording.h"
+
+#include <AzCore/std/string/string.h>
+
+namespace EnhancedInput
+{
+    namespace
+    {
+        constexpr AZ::u8 RecordingMagic[4] = { 'E', 'I', 'R', 'C' };
+        // Version 2 added State records; version 1 recordings are still read and replay from live state.
+        constexpr AZ::u32 RecordingVersion = 2;
+        constexpr AZ::u32 MinRecordingVersion = 1;
+        constexpr size_t HeaderSize = 8;
+
+        constexpr AZ::u8 TypeMask = 0x03;
+        constexpr AZ::u8 ValueZeroFlag = 0x04;
+        constexpr AZ::u8 ValueOneFlag = 0x08;
+        constexpr AZ::u8 UserChangedFlag = 0x10;
+
+        void WriteVarint(AZStd::vector<AZ::u8>& buffer, AZ::u64 value)
+        {
+            while (value >= 0x80)
+            {
+                buffer.push_back(static_cast<AZ::u8>(value | 0x80));
+                value >>= 7;
+            }
+            buffer.push_back(static_cast<AZ::u8>(value));
+        }
+
+        void WriteU32(AZStd::vector<AZ::u8>& buffer, AZ::u32 value)
+        {
+            for (int byte = 0; byte < 4; ++byte)
+            {
+                buffer.push_back(static_cast<AZ::u8>(value >> (byte * 8)));
+            }
+        }
+
+        void WriteFloat(AZStd::vector<AZ::u8>& buffer, float value)
+        {
+            AZ::u32 bits;
+            memcpy(&bits, &value, sizeof(bits));
+            WriteU32(buffer, bits);
+        }
+
+        bool ReadVarint(const AZ::u8* data, size_t size, size_t& offset, AZ::u64& value)
+        {
+            value = 0;
+            for (AZ::u32 shift = 0; shift < 64 && offset < size; shift += 7)
+            {
+                const AZ::u8 byte = data[offset++];
+                value |= static_cast<AZ::u64>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool ReadU32(const AZ::u8* data, size_t size, size_t& offset, AZ::u32& value)
+        {
+            if (size - offset < 4)
+            {
+                return false;
+            }
+
+            value = 0;
+            for (int byte = 0; byte < 4; ++byte)
+            {
+                value |= static_cast<AZ::u32>(data[offset++]) << (byte * 8);
+            }
+            return true;
+        }
+
+        bool ReadFloat(const AZ::u8* data, size_t size, size_t& offset, float& value)
+        {
+            AZ::u32 bits;
+            if (!ReadU32(data, size, offset, bits))
+            {
+                return false;
+            }
+            memcpy(&value, &bits, sizeof(value));
+            return true;
+        }
+    } // namespace
+
+    InputRecordWriter::~InputRecordWriter()
+    {
+        Stop();
+    }
+
+    bool InputRecordWriter::Start(const char* path)
+    {
+        Stop();
+
+        if (!m_file.Open(path, AZ::IO::SystemFile::SF_OPEN_CREATE | AZ::IO::SystemFile::SF_OPEN_CREATE_PATH | AZ::IO::SystemFile::SF_OPEN_WRITE_ONLY))
+        {
+            AZ_Warning("EnhancedInput", false, "Could not open input recording '%s' for writing.", path);
+            return false;
+        }
+
+        m_buffer.clear();
+        m_buffer.reserve(FlushSize);
+        m_buffer.insert(m_buffer.end(), AZStd::begin(RecordingMagic), AZStd::end(RecordingMagic));
+        WriteU32(m_buffer, RecordingVersion);
+        m_channelSlots.clear();
+        m_lastTimeUs = 0;
+        m_lastLocalUserId = static_cast<AZ::u32>(AzFramework::LocalUserIdAny);
+
+        m_isStopping = false;
+        m_isRecording = true;
+        AZStd::thread_desc threadDesc;
+        threadDesc.m_name = "EnhancedInput Recording";
+        m_writerThread = AZStd::thread(threadDesc, [this]() { RunWriterThread(); });
+        return true;
+    }
+
+    void InputRecordWriter::Stop()
+    {
+        if (!m_isRecording)
+        {
+            return;
+        }
+
+        HandOffBuffer();
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            m_isStopping = true;
+        }
+        m_condition.notify_one();
+        m_writerThread.join();
+
+        m_file.Close();
+        m_pendingBuffers.clear();
+        m_freeBuffers.clear();
+        m_isRecording = false;
+    }
+
+    void InputRecordWriter::WriteEvent(AZStd::sys_time_t timeUs, AzFramework::LocalUserId localUserId, AZ::u32 channelCrc, float value)
+    {
+        auto slotIt = m_channelSlots.find(channelCrc);
+        if (slotIt == m_channelSlots.end())
+        {
+            WriteRecordStart(InputRecordType::Channel, 0, timeUs);
+            WriteU32(m_buffer, channelCrc);
+            slotIt = m_channelSlots.emplace(channelCrc, static_cast<AZ::u32>(m_channelSlots.size())).first;
+        }
+
+        const AZ::u32 userId = static_cast<AZ::u32>(localUserId);
+        AZ::u8 flags = value == 0.0f ? ValueZeroFlag : (value == 1.0f ? ValueOneFlag : 0);
+        if (userId != m_lastLocalUserId)
+        {
+            flags |= UserChangedFlag;
+        }
+
+        WriteRecordStart(InputRecordType::Event, flags, timeUs);
+        WriteVarint(m_buffer, slotIt->second);
+        if (flags & UserChangedFlag)
+        {
+            WriteVarint(m_buffer, userId);
+            m_lastLocalUserId = userId;
+        }
+        if ((flags & (ValueZeroFlag | ValueOneFlag)) == 0)
+        {
+            WriteFloat(m_buffer, value);
+        }
+
+        if (m_buffer.size() >= FlushSize)
+        {
+            HandOffBuffer();
+        }
+    }
+
+    void InputRecordWriter::WriteTick(AZStd::sys_time_t timeUs, float deltaTime)
+    {
+        WriteRecordStart(InputRecordType::Tick, 0, timeUs);
+        WriteFloat(m_buffer, deltaTime);
+
+        if (m_buffer.size() >= FlushSize)
+        {
+            HandOffBuffer();
+        }
+    }
+
+    void InputRecordWriter::WriteState(AZStd::sys_time_t timeUs, AzFramework::LocalUserId localUserId, const AZStd::vector<AZ::u8>& state)
+    {
+        WriteRecordStart(InputRecordType::State, 0, timeUs);
+        WriteVarint(m_buffer, static_cast<AZ::u32>(localUserId));
+        WriteVarint(m_buffer, state.size());
+        m_buffer.insert(m_buffer.end(), state.begin(), state.end());
+
+        if (m_buffer.size() >= FlushSize)
+        {
+            HandOffBuffer();
+        }
+    }
+
+    void InputRecordWriter::WriteRecordStart(InputRecordType type, AZ::u8 flags, AZStd::sys_time_t timeUs)
+    {
+        // Zigzag, since events timestamped by another thread may land slightly before the previous record.
+        const AZ::s64 delta = static_cast<AZ::s64>(timeUs - m_lastTimeUs);
+        m_buffer.push_back(static_cast<AZ::u8>(type) | flags);
+        WriteVarint(m_buffer, (static_cast<AZ::u64>(delta) << 1) ^ static_cast<AZ::u64>(delta >> 63));
+        m_lastTimeUs = timeUs;
+    }
+
+    void InputRecordWriter::HandOffBuffer()
+    {
+        if (m_buffer.empty())
+        {
+            return;
+        }
+
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            m_pendingBuffers.push_back(AZStd::move(m_buffer));
+            m_buffer.clear();
+            if (!m_freeBuffers.empty())
+            {
+                m_buffer = AZStd::move(m_freeBuffers.back());
+                m_freeBuffers.pop_back();
+            }
+        }
+        m_condition.notify_one();
+        m_buffer.reserve(FlushSize);
+    }
+
+    void InputRecordWriter::RunWriterThread()
+    {
+        AZStd::vector<AZStd::vector<AZ::u8>> writing;
+        AZStd::unique_lock<AZStd::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_condition.wait(lock, [this]() { return m_isStopping || !m_pendingBuffers.empty(); });
+            if (m_pendingBuffers.empty())
+            {
+                return;
+            }
+
+            AZStd::swap(writing, m_pendingBuffers);
+            lock.unlock();
+            for (AZStd::vector<AZ::u8>& buffer : writing)
+            {
+                m_file.Write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+            lock.lock();
+
+            for (AZStd::vector<AZ::u8>& buffer : writing)
+            {
+                m_freeBuffers.push_back(AZStd::move(buffer));
+            }
+            writing.clear();
+        }
+    }
+
+    bool InputRecordReader::Load(const char* path)
+    {
+        Close();
+
+        if (!m_file.Open(path, AZ::IO::SystemFile::SF_OPEN_READ_ONLY))
+        {
+            AZ_Warning("EnhancedInput", false, "Could not read input recording '%s'.", path);
+            return false;
+        }
+
+        // Only the first chunk is read up front, so even a long session starts replaying at once.
+        m_ownedData.resize(ChunkSize);
+        const size_t size = m_file.Read(m_ownedData.size(), m_ownedData.data());
+        if (!Open(m_ownedData.data(), size))
+        {
+            return false;
+        }
+        m_isStreaming = true;
+        return true;
+    }
+
+    bool InputRecordReader::Open(const AZ::u8* data, size_t size)
+    {
+        m_channelCrcs.clear();
+        m_lastTimeUs = 0;
+        m_lastLocalUserId = static_cast<AZ::u32>(AzFramework::LocalUserIdAny);
+        m_dataFileOffset = 0;
+
+        size_t offset = sizeof(RecordingMagic);
+        AZ::u32 version = 0;
+        if (size < HeaderSize || memcmp(data, RecordingMagic, sizeof(RecordingMagic)) != 0 || !ReadU32(data, size, offset, version) ||
+            version < MinRecordingVersion || version > RecordingVersion)
+        {
+            AZ_Warning("EnhancedInput", false, "Not an input recording of version %u to %u.", MinRecordingVersion, RecordingVersion);
+            Close();
+            return false;
+        }
+
+        m_data = data;
+        m_size = size;
+        m_offset = HeaderSize;
+        return true;
+    }
+
+    void InputRecordReader::Close()
+    {
+        if (m_file.IsOpen())
+        {
+            m_file.Close();
+        }
+        m_isStreaming = false;
+        m_ownedData.clear();
+        m_data = nullptr;
+        m_size = 0;
+        m_offset = 0;
+        m_dataFileOffset = 0;
+    }
+
+    bool InputRecordReader::Read(InputRecord& record)
+    {
+        while (true)
+        {
+            // A record cut off at the end of the chunk is decoded again from its start once the next chunk is in.
+            const size_t recordStart = m_offset;
+            const AZStd::sys_time_t lastTimeUs = m_lastTimeUs;
+            const AZ::u32 lastLocalUserId = m_lastLocalUserId;
+
+            const DecodeResult result = m_offset < m_size ? DecodeRecord(record) : DecodeResult::Incomplete;
+            if (result == DecodeResult::Decoded)
+            {
+                return true;
+            }
+            if (result == DecodeResult::Skipped)
+            {
+                continue;
+            }
+
+            m_offset = recordStart;
+            m_lastTimeUs = lastTimeUs;
+            m_lastLocalUserId = lastLocalUserId;
+            if (result == DecodeResult::Malformed || !ReadNextChunk())
+            {
+                break;
+            }
+        }
+
+        AZ_Warning("EnhancedInput", m_offset >= m_size, "Input recording is malformed at byte %zu.", m_dataFileOffset + m_offset);
+        m_offset = m_size;
+        return false;
+    }
+
+    bool InputRecordReader::IsAtStateRecord()
+    {
+        if (m_offset >= m_size && !ReadNextChunk())
+        {
+            return false;
+        }
+        return static_cast<InputRecordType>(m_data[m_offset] & TypeMask) == InputRecordType::State;
+    }
+
+    bool InputRecordReader::ReadNextChunk()
+    {
+        if (!m_isStreaming)
+        {
+            return false;
+        }
+
+        // Keeps the unread tail, growing the buffer only for a record larger than it, such as a big State record.
+        const size_t unread = m_size - m_offset;
+        memmove(m_ownedData.data(), m_ownedData.data() + m_offset, unread);
+        if (unread == m_ownedData.size())
+        {
+            m_ownedData.resize(m_ownedData.size() * 2);
+        }
+
+        const size_t read = m_file.Read(m_ownedData.size() - unread, m_ownedData.data() + unread);
+        m_dataFileOffset += m_offset;
+        m_data = m_ownedData.data();
+        m_size = unread + read;
+        m_offset = 0;
+        return read > 0;
+    }
+
+    InputRecordReader::DecodeResult InputRecordReader::DecodeRecord(InputRecord& record)
+    {
+        // Running out of bytes means the record continues in the next chunk; anything else that does not decode is malformed.
+        const AZ::u8 tag = m_data[m_offset++];
+        AZ::u64 zigzagDelta = 0;
+        if (!ReadVarint(m_data, m_size, m_offset, zigzagDelta))
+        {
+            return DecodeResult::Incomplete;
+        }
+        m_lastTimeUs += static_cast<AZStd::sys_time_t>((zigzagDelta >> 1) ^ (0 - (zigzagDelta & 1)));
+
+        record.m_type = static_cast<InputRecordType>(tag & TypeMask);
+        record.m_timeUs = m_lastTimeUs;
+
+        if (record.m_type == InputRecordType::Channel)
+        {
+            AZ::u32 channelCrc = 0;
+            if (!ReadU32(m_data, m_size, m_offset, channelCrc))
+            {
+                return DecodeResult::Incomplete;
+            }
+            m_channelCrcs.push_back(channelCrc);
+            return DecodeResult::Skipped;
+        }
+
+        if (record.m_type == InputRecordType::Tick)
+        {
+            return ReadFloat(m_data, m_size, m_offset, record.m_deltaTime) ? DecodeResult::Decoded : DecodeResult::Incomplete;
+        }
+
+        if (record.m_type == InputRecordType::State)
+        {
+            AZ::u64 userId = 0;
+            AZ::u64 stateSize = 0;
+            if (!ReadVarint(m_data, m_size, m_offset, userId) || !ReadVarint(m_data, m_size, m_offset, stateSize) ||
+                stateSize > m_size - m_offset)
+            {
+                return DecodeResult::Incomplete;
+            }
+            record.m_localUserId = AzFramework::LocalUserId(static_cast<AZ::u32>(userId));
+            record.m_state = m_data + m_offset;
+            record.m_stateSize = static_cast<size_t>(stateSize);
+            m_offset += record.m_stateSize;
+            return DecodeResult::Decoded;
+        }
+
+        AZ::u64 slot = 0;
+        if (!ReadVarint(m_data, m_size, m_offset, slot))
+        {
+            return DecodeResult::Incomplete;
+        }
+        if (slot >= m_channelCrcs.size())
+        {
+            return DecodeResult::Malformed;
+        }
+        record.m_channelCrc = m_channelCrcs[slot];
+
+        if (tag & UserChangedFlag)
+        {
+            AZ::u64 userId = 0;
+            if (!ReadVarint(m_data, m_size, m_offset, userId))
+            {
+                return DecodeResult::Incomplete;
+            }
+            m_lastLocalUserId = static_cast<AZ::u32>(userId);
+        }
+        record.m_localUserId = AzFramework::LocalUserId(m_lastLocalUserId);
+
+        if (tag & ValueZeroFlag)
+        {
+            record.m_value = 0.0f;
+        }
+        else if (tag & ValueOneFlag)
+        {
+            record.m_value = 1.0f;
+        }
+        else if (!ReadFloat(m_data, m_size, m_offset, record.m_value))
+        {
+            return DecodeResult::Incomplete;
+        }
+        return DecodeResult::Decoded;
+    }
+
+} // namespace EnhancedInput
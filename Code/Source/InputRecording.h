@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/conditional_variable.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/parallel/thread.h>
+#include <AzCore/std/time.h>
+#include <AzFramework/Input/User/LocalUserId.h>
+
+namespace EnhancedInput
+{
+    //! Input recordings are a byte stream without alignment requirements or pointers, so a recording mapped into memory
+    //! can be read in place. After an 8 byte header ("EIRC" and a version), every record starts with a tag byte:
+    //! - the low two bits hold the InputRecordType;
+    //! - every record continues with the zigzag varint time since the previous record, in microseconds;
+    //! - Channel records carry the 4 byte channel name CRC and assign it the next channel slot;
+    //! - Event records carry a varint channel slot, a varint local user id only if it differs from the previous
+    //!   event's, and a 4 byte value unless the tag marks it as 0 or 1;
+    //! - Tick records carry the 4 byte tick delta time;
+    //! - State records carry a varint local user id, a varint byte count and that many bytes of the user's saved
+    //!   pipeline state. A recording opens with one for every pipeline, so replay starts where recording did.
+    //! Multi-byte fields are little endian.
+    enum class InputRecordType : AZ::u8
+    {
+        Tick = 0,
+        Event = 1,
+        Channel = 2,
+        State = 3,
+    };
+
+    struct InputRecord
+    {
+        InputRecordType m_type = InputRecordType::Tick;
+        AZStd::sys_time_t m_timeUs = 0;
+        // Event records only.
+        AzFramework::LocalUserId m_localUserId = AzFramework::LocalUserIdAny;
+        AZ::u32 m_channelCrc = 0;
+        float m_value = 0.0f;
+        // Tick records only.
+        float m_deltaTime = 0.0f;
+        // State records only, also using m_localUserId. Points into the reader's data, valid until the next Read.
+        const AZ::u8* m_state = nullptr;
+        size_t m_stateSize = 0;
+    };
+
+    //! Encodes channel events and ticks on the calling thread and writes them to disk from a thread of its own,
+    //! so recording never waits on the file system. Filled buffers are recycled once written.
+    class InputRecordWriter
+    {
+    public:
+        ~InputRecordWriter();
+
+        bool Start(const char* path);
+        //! Writes everything recorded so far and closes the file.
+        void Stop();
+        bool IsRecording() const { return m_isRecording; }
+
+        void WriteEvent(AZStd::sys_time_t timeUs, AzFramework::LocalUserId localUserId, AZ::u32 channelCrc, float value);
+        void WriteTick(AZStd::sys_time_t timeUs, float deltaTime);
+        void WriteState(AZStd::sys_time_t timeUs, AzFramework::LocalUserId localUserId, const AZStd::vector<AZ::u8>& state);
+
+    private:
+        static constexpr size_t FlushSize = 64 * 1024;
+
+        void WriteRecordStart(InputRecordType type, AZ::u8 flags, AZStd::sys_time_t timeUs);
+        void HandOffBuffer();
+        void RunWriterThread();
+
+        bool m_isRecording = false;
+        AZStd::vector<AZ::u8> m_buffer;
+        // Channel name CRC -> slot assigned by its Channel record.
+        AZStd::unordered_map<AZ::u32, AZ::u32> m_channelSlots;
+        AZStd::sys_time_t m_lastTimeUs = 0;
+        AZ::u32 m_lastLocalUserId = static_cast<AZ::u32>(AzFramework::LocalUserIdAny);
+
+        AZ::IO::SystemFile m_file;
+        AZStd::thread m_writerThread;
+        AZStd::mutex m_mutex;
+        AZStd::condition_variable m_condition;
+        AZStd::vector<AZStd::vector<AZ::u8>> m_pendingBuffers;
+        AZStd::vector<AZStd::vector<AZ::u8>> m_freeBuffers;
+        bool m_isStopping = false;
+    };
+
+    //! Decodes a recording record by record, either streamed from a file a chunk at a time or in place from memory
+    //! the caller keeps alive, such as a mapped view of the file. Streaming keeps memory use flat and starts a long
+    //! recording as fast as a mapping would, without a platform specific mapping API.
+    class InputRecordReader
+    {
+    public:
+        bool Load(const char* path);
+        bool Open(const AZ::u8* data, size_t size);
+        void Close();
+
+        //! Returns false at the end of the recording, or if the rest of it is malformed.
+        bool Read(InputRecord& record);
+        //! Whether the next record is a State record, which recordings only have at their start.
+        bool IsAtStateRecord();
+
+    private:
+        static constexpr size_t ChunkSize = 64 * 1024;
+
+        enum class DecodeResult
+        {
+            Decoded,
+            // A Channel record, which only feeds the reader's own slot table.
+            Skipped,
+            // The record runs past the end of the data read so far.
+            Incomplete,
+            Malformed,
+        };
+
+        DecodeResult DecodeRecord(InputRecord& record);
+        //! Moves the unread tail to the front of the buffer and fills the rest from the file. False when nothing was read.
+        bool ReadNextChunk();
+
+        AZ::IO::SystemFile m_file;
+        bool m_isStreaming = false;
+        AZStd::vector<AZ::u8> m_ownedData;
+        const AZ::u8* m_data = nullptr;
+        size_t m_size = 0;
+        size_t m_offset = 0;
+        // File position of m_data[0], for error messages.
+        size_t m_dataFileOffset = 0;
+        AZStd::vector<AZ::u32> m_channelCrcs;
+        AZStd::sys_time_t m_lastTimeUs = 0;
+        AZ::u32 m_lastLocalUserId = static_cast<AZ::u32>(AzFramework::LocalUserIdAny);
+    };
+
+} // namespace EnhancedInput
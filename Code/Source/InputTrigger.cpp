@@ -11,6 +11,35 @@
 
 namespace EnhancedInput
 {
+    namespace
+    {
+        // Calls the trigger's own UpdateState non-virtually, so the compiler can inline it into the batch loop.
+        template<class Trigger>
+        void UpdateTriggerStates(const Trigger& trigger, TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive,
+            TriggerState* states, AZ::u32 count, const TriggerTimeStep& timeStep)
+        {
+            for (AZ::u32 index = 0; index < count; ++index)
+            {
+                if (isActive[index])
+                {
+                    states[index] = trigger.Trigger::UpdateState(runtimeStates[index], values[index], timeStep);
+                }
+            }
+        }
+    } // namespace
+
+    void InputTrigger::UpdateStates(TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive, TriggerState* states,
+        AZ::u32 count, const TriggerTimeStep& timeStep) const
+    {
+        for (AZ::u32 index = 0; index < count; ++index)
+        {
+            if (isActive[index])
+            {
+                states[index] = UpdateState(runtimeStates[index], values[index], timeStep);
+            }
+        }
+    }
+
     void InputTrigger::Reflect(AZ::ReflectContext* context)
     {
         if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
@@ -20,25 +49,68 @@ namespace EnhancedInput
         }
     }
 
-    TriggerState InputTriggerPressed::UpdateState(const InputValue& value, [[maybe_unused]] float deltaTime)
+    void InputTrigger::AdvanceTimer(TriggerRuntimeState& runtimeState, const TriggerTimeStep& timeStep)
+    {
+        if (timeStep.m_isDeterministic)
+        {
+            runtimeState.m_elapsedUs += timeStep.m_deltaTimeUs;
+        }
+        else
+        {
+            runtimeState.m_elapsedTime += timeStep.m_deltaTime;
+        }
+    }
+
+    void InputTrigger::ResetTimer(TriggerRuntimeState& runtimeState)
+    {
+        runtimeState.m_elapsedTime = 0.0f;
+        runtimeState.m_elapsedUs = 0;
+    }
+
+    bool InputTrigger::HasTimerReached(const TriggerRuntimeState& runtimeState, const TriggerTimeStep& timeStep, float duration)
+    {
+        return timeStep.m_isDeterministic ? runtimeState.m_elapsedUs >= SecondsToMicroseconds(duration) : runtimeState.m_elapsedTime >= duration;
+    }
+
+    AZ::u32 InputTrigger::RestartTimer(TriggerRuntimeState& runtimeState, const TriggerTimeStep& timeStep, float period)
+    {
+        const AZ::s64 periodUs = SecondsToMicroseconds(period);
+        if (timeStep.m_isDeterministic && periodUs > 0)
+        {
+            const AZ::s64 periodCount = AZ::GetMax(runtimeState.m_elapsedUs / periodUs, AZ::s64(1));
+            runtimeState.m_elapsedUs = AZ::GetMax(runtimeState.m_elapsedUs - periodCount * periodUs, AZ::s64(0));
+            return static_cast<AZ::u32>(periodCount);
+        }
+
+        ResetTimer(runtimeState);
+        return 1;
+    }
+
+    TriggerState InputTriggerPressed::UpdateState(TriggerRuntimeState& runtimeState, const InputValue& value, [[maybe_unused]] const TriggerTimeStep& timeStep) const
     {
         bool isPressed = !value.IsZero();
 
-        if (isPressed && !m_wasPressed)
+        if (isPressed && !runtimeState.m_wasPressed)
         {
-            m_state = TriggerState::Started;
+            runtimeState.m_state = TriggerState::Started;
         }
-        else if (!isPressed && m_wasPressed)
+        else if (!isPressed && runtimeState.m_wasPressed)
         {
-            m_state = TriggerState::Completed;
+            runtimeState.m_state = TriggerState::Completed;
         }
         else
         {
-            m_state = TriggerState::None;
+            runtimeState.m_state = TriggerState::None;
         }
 
-        m_wasPressed = isPressed;
-        return m_state;
+        runtimeState.m_wasPressed = isPressed;
+        return runtimeState.m_state;
+    }
+
+    void InputTriggerPressed::UpdateStates(TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive, TriggerState* states,
+        AZ::u32 count, const TriggerTimeStep& timeStep) const
+    {
+        UpdateTriggerStates(*this, runtimeStates, values, isActive, states, count, timeStep);
     }
 
     void InputTriggerPressed::Reflect(AZ::ReflectContext* context)
@@ -57,21 +129,27 @@ namespace EnhancedInput
         }
     }
 
-    TriggerState InputTriggerReleased::UpdateState(const InputValue& value, [[maybe_unused]] float deltaTime)
+    TriggerState InputTriggerReleased::UpdateState(TriggerRuntimeState& runtimeState, const InputValue& value, [[maybe_unused]] const TriggerTimeStep& timeStep) const
     {
         bool isPressed = !value.IsZero();
 
-        if (!isPressed && m_wasPressed)
+        if (!isPressed && runtimeState.m_wasPressed)
         {
-            m_state = TriggerState::Triggered;
+            runtimeState.m_state = TriggerState::Triggered;
         }
         else
         {
-            m_state = TriggerState::None;
+            runtimeState.m_state = TriggerState::None;
         }
 
-        m_wasPressed = isPressed;
-        return m_state;
+        runtimeState.m_wasPressed = isPressed;
+        return runtimeState.m_state;
+    }
+
+    void InputTriggerReleased::UpdateStates(TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive, TriggerState* states,
+        AZ::u32 count, const TriggerTimeStep& timeStep) const
+    {
+        UpdateTriggerStates(*this, runtimeStates, values, isActive, states, count, timeStep);
     }
 
     void InputTriggerReleased::Reflect(AZ::ReflectContext* context)
@@ -90,29 +168,35 @@ namespace EnhancedInput
         }
     }
 
-    TriggerState InputTriggerDown::UpdateState(const InputValue& value, [[maybe_unused]] float deltaTime)
+    TriggerState InputTriggerDown::UpdateState(TriggerRuntimeState& runtimeState, const InputValue& value, [[maybe_unused]] const TriggerTimeStep& timeStep) const
     {
         bool isPressed = !value.IsZero();
 
-        if (isPressed && !m_wasPressed)
+        if (isPressed && !runtimeState.m_wasPressed)
         {
-            m_state = TriggerState::Started;
+            runtimeState.m_state = TriggerState::Started;
         }
-        else if (isPressed && m_wasPressed)
+        else if (isPressed && runtimeState.m_wasPressed)
         {
-            m_state = TriggerState::Ongoing;
+            runtimeState.m_state = TriggerState::Ongoing;
         }
-        else if (!isPressed && m_wasPressed)
+        else if (!isPressed && runtimeState.m_wasPressed)
         {
-            m_state = TriggerState::Completed;
+            runtimeState.m_state = TriggerState::Completed;
         }
         else
         {
-            m_state = TriggerState::None;
+            runtimeState.m_state = TriggerState::None;
         }
 
-        m_wasPressed = isPressed;
-        return m_state;
+        runtimeState.m_wasPressed = isPressed;
+        return runtimeState.m_state;
+    }
+
+    void InputTriggerDown::UpdateStates(TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive, TriggerState* states,
+        AZ::u32 count, const TriggerTimeStep& timeStep) const
+    {
+        UpdateTriggerStates(*this, runtimeStates, values, isActive, states, count, timeStep);
     }
 
     void InputTriggerDown::Reflect(AZ::ReflectContext* context)
@@ -131,51 +215,55 @@ namespace EnhancedInput
         }
     }
 
-    TriggerState InputTriggerHold::UpdateState(const InputValue& value, float deltaTime)
+    TriggerState InputTriggerHold::UpdateState(TriggerRuntimeState& runtimeState, const InputValue& value, const TriggerTimeStep& timeStep) const
     {
         if (!value.IsZero())
         {
-            m_elapsedTime += deltaTime;
+            AdvanceTimer(runtimeState, timeStep);
 
-            if (m_elapsedTime >= m_holdTime)
+            if (HasTimerReached(runtimeState, timeStep, m_holdTime))
             {
-                if (m_triggerOnce && m_hasTriggered)
+                if (m_triggerOnce && runtimeState.m_hasTriggered)
                 {
-                    m_state = TriggerState::Ongoing;
+                    runtimeState.m_state = TriggerState::Ongoing;
                 }
                 else
                 {
-                    m_state = TriggerState::Triggered;
-                    m_hasTriggered = true;
+                    runtimeState.m_state = TriggerState::Triggered;
+                    runtimeState.m_hasTriggered = true;
                 }
             }
             else
             {
-                m_state = TriggerState::Ongoing;
+                runtimeState.m_state = TriggerState::Ongoing;
             }
         }
         else
         {
-            if (m_state == TriggerState::Ongoing || m_state == TriggerState::Triggered)
+            if (runtimeState.m_state == TriggerState::Ongoing || runtimeState.m_state == TriggerState::Triggered)
             {
-                m_state = TriggerState::Canceled;
+                runtimeState.m_state = TriggerState::Canceled;
             }
             else
             {
-                m_state = TriggerState::None;
+                runtimeState.m_state = TriggerState::None;
             }
-            m_elapsedTime = 0.0f;
-            m_hasTriggered = false;
+            ResetTimer(runtimeState);
+            runtimeState.m_hasTriggered = false;
         }
 
-        return m_state;
+        return runtimeState.m_state;
+    }
+
+    void InputTriggerHold::UpdateStates(TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive, TriggerState* states,
+        AZ::u32 count, const TriggerTimeStep& timeStep) const
+    {
+        UpdateTriggerStates(*this, runtimeStates, values, isActive, states, count, timeStep);
     }
 
-    void InputTriggerHold::Reset()
+    bool InputTriggerHold::IsTimerRunning(const TriggerRuntimeState& runtimeState) const
     {
-        InputTrigger::Reset();
-        m_elapsedTime = 0.0f;
-        m_hasTriggered = false;
+        return runtimeState.m_state == TriggerState::Ongoing || runtimeState.m_state == TriggerState::Triggered;
     }
 
     void InputTriggerHold::Reflect(AZ::ReflectContext* context)
@@ -198,44 +286,50 @@ namespace EnhancedInput
         }
     }
 
-    TriggerState InputTriggerTap::UpdateState(const InputValue& value, float deltaTime)
+    TriggerState InputTriggerTap::UpdateState(TriggerRuntimeState& runtimeState, const InputValue& value, const TriggerTimeStep& timeStep) const
     {
         bool isPressed = !value.IsZero();
 
         if (isPressed)
         {
-            if (!m_wasPressed)
+            if (!runtimeState.m_wasPressed)
             {
-                m_elapsedTime = 0.0f;
+                ResetTimer(runtimeState);
             }
             else
             {
-                m_elapsedTime += deltaTime;
+                AdvanceTimer(runtimeState, timeStep);
             }
-            m_state = TriggerState::Ongoing;
+            runtimeState.m_state = TriggerState::Ongoing;
         }
         else
         {
-            if (m_wasPressed && m_elapsedTime <= m_maxTapTime)
+            const bool isWithinTapTime = timeStep.m_isDeterministic ? runtimeState.m_elapsedUs <= SecondsToMicroseconds(m_maxTapTime)
+                                                                    : runtimeState.m_elapsedTime <= m_maxTapTime;
+            if (runtimeState.m_wasPressed && isWithinTapTime)
             {
-                m_state = TriggerState::Triggered;
+                runtimeState.m_state = TriggerState::Triggered;
             }
             else
             {
-                m_state = TriggerState::None;
+                runtimeState.m_state = TriggerState::None;
             }
-            m_elapsedTime = 0.0f;
+            ResetTimer(runtimeState);
         }
 
-        m_wasPressed = isPressed;
-        return m_state;
+        runtimeState.m_wasPressed = isPressed;
+        return runtimeState.m_state;
     }
 
-    void InputTriggerTap::Reset()
+    void InputTriggerTap::UpdateStates(TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive, TriggerState* states,
+        AZ::u32 count, const TriggerTimeStep& timeStep) const
     {
-        InputTrigger::Reset();
-        m_elapsedTime = 0.0f;
-        m_wasPressed = false;
+        UpdateTriggerStates(*this, runtimeStates, values, isActive, states, count, timeStep);
+    }
+
+    bool InputTriggerTap::IsTimerRunning(const TriggerRuntimeState& runtimeState) const
+    {
+        return runtimeState.m_wasPressed;
     }
 
     void InputTriggerTap::Reflect(AZ::ReflectContext* context)
@@ -256,44 +350,51 @@ namespace EnhancedInput
         }
     }
 
-    TriggerState InputTriggerPulse::UpdateState(const InputValue& value, float deltaTime)
+    TriggerState InputTriggerPulse::UpdateState(TriggerRuntimeState& runtimeState, const InputValue& value, const TriggerTimeStep& timeStep) const
     {
         if (!value.IsZero())
         {
-            m_timeSinceLastTrigger += deltaTime;
+            AdvanceTimer(runtimeState, timeStep);
 
-            if (m_isFirstTrigger && m_triggerOnStart)
+            if (!runtimeState.m_hasTriggered && m_triggerOnStart)
             {
-                m_state = TriggerState::Triggered;
-                m_isFirstTrigger = false;
-                m_timeSinceLastTrigger = 0.0f;
+                runtimeState.m_state = TriggerState::Triggered;
+                runtimeState.m_periodCount = 1;
+                runtimeState.m_hasTriggered = true;
+                ResetTimer(runtimeState);
             }
-            else if (m_timeSinceLastTrigger >= m_interval)
+            else if (HasTimerReached(runtimeState, timeStep, m_interval))
             {
-                m_state = TriggerState::Triggered;
-                m_timeSinceLastTrigger = 0.0f;
-                m_isFirstTrigger = false;
+                runtimeState.m_state = TriggerState::Triggered;
+                runtimeState.m_periodCount = RestartTimer(runtimeState, timeStep, m_interval);
+                runtimeState.m_hasTriggered = true;
             }
             else
             {
-                m_state = TriggerState::Ongoing;
+                runtimeState.m_state = TriggerState::Ongoing;
+                runtimeState.m_periodCount = 0;
             }
         }
         else
         {
-            m_state = TriggerState::None;
-            m_timeSinceLastTrigger = 0.0f;
-            m_isFirstTrigger = true;
+            runtimeState.m_state = TriggerState::None;
+            runtimeState.m_periodCount = 0;
+            ResetTimer(runtimeState);
+            runtimeState.m_hasTriggered = false;
         }
 
-        return m_state;
+        return runtimeState.m_state;
+    }
+
+    void InputTriggerPulse::UpdateStates(TriggerRuntimeState* runtimeStates, const InputValue* values, const AZ::u8* isActive, TriggerState* states,
+        AZ::u32 count, const TriggerTimeStep& timeStep) const
+    {
+        UpdateTriggerStates(*this, runtimeStates, values, isActive, states, count, timeStep);
     }
 
-    void InputTriggerPulse::Reset()
+    bool InputTriggerPulse::IsTimerRunning(const TriggerRuntimeState& runtimeState) const
     {
-        InputTrigger::Reset();
-        m_timeSinceLastTrigger = 0.0f;
-        m_isFirstTrigger = true;
+        return runtimeState.m_state == TriggerState::Ongoing || runtimeState.m_state == TriggerState::Triggered;
     }
 
     void InputTriggerPulse::Reflect(AZ::ReflectContext* context)
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "ModifierBatch.h"
+
+#include <AzCore/Math/Simd.h>
+#include <AzCore/std/algorithm.h>
+
+namespace EnhancedInput
+{
+    namespace
+    {
+        using Vec4 = AZ::Simd::Vec4;
+        using FloatType = Vec4::FloatType;
+
+        struct Lanes
+        {
+            FloatType m_x;
+            FloatType m_y;
+            FloatType m_z;
+        };
+
+        FloatType ApplyAxialDeadZone(FloatType value, FloatType lowerThreshold, FloatType range)
+        {
+            const FloatType zero = Vec4::ZeroFloat();
+            const FloatType absValue = Vec4::Abs(value);
+            FloatType scaled = Vec4::Min(Vec4::Div(Vec4::Sub(absValue, lowerThreshold), range), Vec4::Splat(1.0f));
+            scaled = Vec4::Select(zero, scaled, Vec4::CmpLt(absValue, lowerThreshold));
+            return Vec4::Select(Vec4::Sub(zero, scaled), scaled, Vec4::CmpLt(value, zero));
+        }
+
+        FloatType GetLength(const Lanes& lanes)
+        {
+            FloatType lengthSq = Vec4::Mul(lanes.m_x, lanes.m_x);
+            lengthSq = Vec4::Madd(lanes.m_y, lanes.m_y, lengthSq);
+            lengthSq = Vec4::Madd(lanes.m_z, lanes.m_z, lengthSq);
+            return Vec4::Sqrt(lengthSq);
+        }
+
+        void Scale(Lanes& lanes, FloatType factor)
+        {
+            lanes.m_x = Vec4::Mul(lanes.m_x, factor);
+            lanes.m_y = Vec4::Mul(lanes.m_y, factor);
+            lanes.m_z = Vec4::Mul(lanes.m_z, factor);
+        }
+
+        void ApplyOp(const ModifierOp& op, Lanes& lanes)
+        {
+            const FloatType zero = Vec4::ZeroFloat();
+            const FloatType one = Vec4::Splat(1.0f);
+            switch (op.m_code)
+            {
+            case ModifierOpCode::Linear:
+            {
+                FloatType rows[3];
+                for (int row = 0; row < 3; ++row)
+                {
+                    rows[row] = Vec4::Mul(lanes.m_x, Vec4::Splat(op.m_matrix.GetElement(row, 0)));
+                    rows[row] = Vec4::Madd(lanes.m_y, Vec4::Splat(op.m_matrix.GetElement(row, 1)), rows[row]);
+                    rows[row] = Vec4::Madd(lanes.m_z, Vec4::Splat(op.m_matrix.GetElement(row, 2)), rows[row]);
+                }
+                lanes = { rows[0], rows[1], rows[2] };
+                break;
+            }
+            case ModifierOpCode::DeadZoneAxial:
+            {
+                const FloatType lowerThreshold = Vec4::Splat(op.m_params[0]);
+                const FloatType range = Vec4::Splat(op.m_params[1] - op.m_params[0]);
+                lanes.m_x = ApplyAxialDeadZone(lanes.m_x, lowerThreshold, range);
+                lanes.m_y = ApplyAxialDeadZone(lanes.m_y, lowerThreshold, range);
+                lanes.m_z = ApplyAxialDeadZone(lanes.m_z, lowerThreshold, range);
+                break;
+            }
+            case ModifierOpCode::DeadZoneRadial:
+            {
+                // Normalizing and rescaling folds into one factor; lanes inside the dead zone, or of zero length, get 0.
+                const FloatType lowerThreshold = Vec4::Splat(op.m_params[0]);
+                const FloatType range = Vec4::Splat(op.m_params[1] - op.m_params[0]);
+                const FloatType length = GetLength(lanes);
+                const FloatType scaled = Vec4::Min(Vec4::Div(Vec4::Sub(length, lowerThreshold), range), one);
+                const FloatType isInside = Vec4::Or(Vec4::CmpLt(length, lowerThreshold), Vec4::CmpEq(length, zero));
+                Scale(lanes, Vec4::Select(zero, Vec4::Div(scaled, length), isInside));
+                break;
+            }
+            case ModifierOpCode::Clamp:
+            {
+                const FloatType minValue = Vec4::Splat(op.m_params[0]);
+                const FloatType maxValue = Vec4::Splat(op.m_params[1]);
+                lanes.m_x = Vec4::Clamp(lanes.m_x, minValue, maxValue);
+                lanes.m_y = Vec4::Clamp(lanes.m_y, minValue, maxValue);
+                lanes.m_z = Vec4::Clamp(lanes.m_z, minValue, maxValue);
+                break;
+            }
+            case ModifierOpCode::Normalize:
+            {
+                const FloatType length = GetLength(lanes);
+                Scale(lanes, Vec4::Select(one, Vec4::Div(one, length), Vec4::CmpEq(length, zero)));
+                break;
+            }
+            case ModifierOpCode::Custom:
+                // Handled per lane by the caller.
+                break;
+            }
+        }
+    } // namespace
+
+    void RunModifierProgramBatch(const ModifierOp* ops, AZ::u32 opCount, float* x, float* y, float* z, size_t laneCount)
+    {
+        const size_t paddedLaneCount = GetPaddedLaneCount(laneCount);
+        AZStd::fill(y, y + paddedLaneCount, 0.0f);
+        AZStd::fill(z, z + paddedLaneCount, 0.0f);
+        if (opCount == 0)
+        {
+            return;
+        }
+
+        // Every op of the chain runs on one group of lanes while it stays in registers.
+        for (size_t first = 0; first < paddedLaneCount; first += ModifierLaneWidth)
+        {
+            Lanes lanes = { Vec4::LoadUnaligned(x + first), Vec4::LoadUnaligned(y + first), Vec4::LoadUnaligned(z + first) };
+            for (AZ::u32 index = 0; index < opCount; ++index)
+            {
+                const ModifierOp& op = ops[index];
+                if (op.m_code != ModifierOpCode::Custom)
+                {
+                    ApplyOp(op, lanes);
+                    continue;
+                }
+
+                // Modifiers without ops are called one lane at a time, with the value type RunModifierProgram gives them.
+                Vec4::StoreUnaligned(x + first, lanes.m_x);
+                Vec4::StoreUnaligned(y + first, lanes.m_y);
+                Vec4::StoreUnaligned(z + first, lanes.m_z);
+                for (size_t lane = first; lane < AZStd::min(first + ModifierLaneWidth, laneCount); ++lane)
+                {
+                    const InputValue value = index == 0 ? InputValue(x[lane]) : InputValue(AZ::Vector3(x[lane], y[lane], z[lane]));
+                    const AZ::Vector3 result = op.m_modifier->ModifyValue(value).GetAxis3D();
+                    x[lane] = result.GetX();
+                    y[lane] = result.GetY();
+                    z[lane] = result.GetZ();
+                }
+                lanes = { Vec4::LoadUnaligned(x + first), Vec4::LoadUnaligned(y + first), Vec4::LoadUnaligned(z + first) };
+            }
+
+            Vec4::StoreUnaligned(x + first, lanes.m_x);
+            Vec4::StoreUnaligned(y + first, lanes.m_y);
+            Vec4::StoreUnaligned(z + first, lanes.m_z);
+        }
+    }
+
+} // namespace EnhancedInput
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <EnhancedInput/InputModifier.h>
+
+namespace EnhancedInput
+{
+    //! Lanes evaluated per SIMD step. Lane arrays are padded to a multiple of it.
+    constexpr AZ::u32 ModifierLaneWidth = 4;
+
+    inline size_t GetPaddedLaneCount(size_t laneCount)
+    {
+        return (laneCount + ModifierLaneWidth - 1) / ModifierLaneWidth * ModifierLaneWidth;
+    }
+
+    //! Runs one compiled modifier chain over many lanes at once, such as the same binding of many virtual controllers.
+    //! Lanes are structure of arrays: each starts as an Axis1D channel value in x, y and z are zeroed here, and each
+    //! ends as the vector RunModifierProgram returns for its value. The arrays hold GetPaddedLaneCount(laneCount)
+    //! floats; padding lanes are evaluated too and their results are meaningless.
+    void RunModifierProgramBatch(const ModifierOp* ops, AZ::u32 opCount, float* x, float* y, float* z, size_t laneCount);
+
+} // namespace EnhancedInput
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/parallel/atomic.h>
+
+namespace EnhancedInput
+{
+    //! Bounded lock-free queue between exactly one producer thread and one consumer thread.
+    //! Never allocates; a push onto a full queue fails and leaves the decision to the producer.
+    template<typename T, AZ::u32 CapacityT>
+    class SpscQueue
+    {
+        static_assert((CapacityT & (CapacityT - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+    public:
+        static constexpr AZ::u32 Capacity = CapacityT;
+
+        //! Producer thread only.
+        bool TryPush(const T& item)
+        {
+            const AZ::u32 tail = m_tail.load(AZStd::memory_order_relaxed);
+            if (tail - m_head.load(AZStd::memory_order_acquire) == Capacity)
+            {
+                return false;
+            }
+
+            m_items[tail & (Capacity - 1)] = item;
+            m_tail.store(tail + 1, AZStd::memory_order_release);
+            return true;
+        }
+
+        //! Consumer thread only. Several threads may take turns as the consumer if a lock serializes all of their pops.
+        bool TryPop(T& item)
+        {
+            const AZ::u32 head = m_head.load(AZStd::memory_order_relaxed);
+            if (head == m_tail.load(AZStd::memory_order_acquire))
+            {
+                return false;
+            }
+
+            item = m_items[head & (Capacity - 1)];
+            m_head.store(head + 1, AZStd::memory_order_release);
+            return true;
+        }
+
+        //! Only valid while neither side is running.
+        void Clear()
+        {
+            m_head.store(0, AZStd::memory_order_relaxed);
+            m_tail.store(0, AZStd::memory_order_relaxed);
+        }
+
+    private:
+        AZStd::array<T, Capacity> m_items;
+        // Kept on separate cache lines so the two threads do not false-share.
+        alignas(64) AZStd::atomic<AZ::u32> m_head{ 0 };
+        alignas(64) AZStd::atomic<AZ::u32> m_tail{ 0 };
+    };
+
+} // namespace EnhancedInput
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+
+namespace EnhancedInput
+{
+    //! Appends trivially copyable values and arrays of them to a flat byte blob. Writing into a blob that is cleared
+    //! and reused keeps its capacity, so snapshotting the same state again does not allocate.
+    class StateBlobWriter
+    {
+    public:
+        explicit StateBlobWriter(AZStd::vector<AZ::u8>& blob)
+            : m_blob(blob)
+        {
+        }
+
+        template<typename T>
+        void Write(const T& value)
+        {
+            Append(&value, sizeof(T));
+        }
+
+        template<typename Container>
+        void WriteArray(const Container& values)
+        {
+            Append(values.data(), values.size() * sizeof(typename Container::value_type));
+        }
+
+    private:
+        void Append(const void* data, size_t size)
+        {
+            const size_t offset = m_blob.size();
+            m_blob.resize(offset + size);
+            memcpy(m_blob.data() + offset, data, size);
+        }
+
+        AZStd::vector<AZ::u8>& m_blob;
+    };
+
+    //! Reads back what StateBlobWriter wrote, in the same order. Arrays are read into containers already sized by
+    //! the caller, since the layout of a blob is fixed by the state it was taken from.
+    class StateBlobReader
+    {
+    public:
+        StateBlobReader(const AZ::u8* data, size_t size)
+            : m_data(data)
+            , m_size(size)
+        {
+        }
+
+        template<typename T>
+        bool Read(T& value)
+        {
+            return Extract(&value, sizeof(T));
+        }
+
+        template<typename Container>
+        bool ReadArray(Container& values)
+        {
+            return Extract(values.data(), values.size() * sizeof(typename Container::value_type));
+        }
+
+        bool IsAtEnd() const { return m_offset == m_size; }
+
+    private:
+        bool Extract(void* data, size_t size)
+        {
+            if (m_size - m_offset < size)
+            {
+                return false;
+            }
+            memcpy(data, m_data + m_offset, size);
+            m_offset += size;
+            return true;
+        }
+
+        const AZ::u8* m_data = nullptr;
+        size_t m_size = 0;
+        size_t m_offset = 0;
+    };
+
+} // namespace EnhancedInput
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#include "SyntheticClientFrames.h"
+
+#include <AzCore/std/sort.h>
+
+namespace EnhancedInput
+{
+    SyntheticClientFrameGenerator::SyntheticClientFrameGenerator(AZ::u32 clientCount, AZStd::vector<AZ::u32> channelCrcs, AZ::u64 seed)
+        : m_random(seed)
+        , m_clientCount(clientCount)
+        , m_channelCrcs(AZStd::move(channelCrcs))
+        , m_channelValues(static_cast<size_t>(clientCount) * m_channelCrcs.size(), 0.0f)
+    {
+    }
+
+    void SyntheticClientFrameGenerator::GenerateFrames(
+        float deltaTime, AZStd::vector<RemoteInputFrame>& frames, AZStd::vector<RemoteInputEvent>& events)
+    {
+        const AZ::u32 frameLengthUs = AZ::GetMax(static_cast<AZ::u32>(deltaTime * 1000000.0f), 1u);
+        const size_t channelCount = m_channelCrcs.size();
+
+        for (AZ::u32 client = 0; client < m_clientCount; ++client)
+        {
+            RemoteInputFrame& frame = frames.emplace_back();
+            frame.m_clientId = client;
+            frame.m_deltaTime = deltaTime;
+            frame.m_firstEvent = static_cast<AZ::u32>(events.size());
+            frame.m_eventCount = channelCount > 0 ? m_random.GetRandom() % (MaxEventsPerFrame + 1) : 0;
+
+            for (AZ::u32 eventIndex = 0; eventIndex < frame.m_eventCount; ++eventIndex)
+            {
+                const size_t channel = m_random.GetRandom() % channelCount;
+                float& value = m_channelValues[client * channelCount + channel];
+
+                // Half of the changes toggle the channel like a button, the rest move it like an axis.
+                if (m_random.GetRandom() % 2 == 0)
+                {
+                    value = value != 0.0f ? 0.0f : 1.0f;
+                }
+                else
+                {
+                    value = m_random.GetRandomFloat() * 2.0f - 1.0f;
+                }
+
+                RemoteInputEvent& event = events.emplace_back();
+                event.m_channelCrc = m_channelCrcs[channel];
+                event.m_value = value;
+                event.m_timeOffsetUs = m_random.GetRandom() % frameLengthUs;
+            }
+
+            // Offsets were drawn independently of the value sequence, so only the times are put in order.
+            m_offsets.clear();
+            for (AZ::u32 eventIndex = frame.m_firstEvent; eventIndex < frame.m_firstEvent + frame.m_eventCount; ++eventIndex)
+            {
+                m_offsets.push_back(events[eventIndex].m_timeOffsetUs);
+            }
+            AZStd::sort(m_offsets.begin(), m_offsets.end());
+            for (AZ::u32 eventIndex = 0; eventIndex < frame.m_eventCount; ++eventIndex)
+            {
+                events[frame.m_firstEvent + eventIndex].m_timeOffsetUs = m_offsets[eventIndex];
+            }
+        }
+    }
+
+} // namespace EnhancedInput
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/Math/Random.h>
+#include <AzCore/std/containers/vector.h>
+#include <EnhancedInput/EnhancedInputBus.h>
+
+namespace EnhancedInput
+{
+    //! Deterministic stand-in for a crowd of networked clients, for load testing EvaluateRemoteFrames.
+    //! Each generated frame presses, releases or moves a few of the given channels at random times within the frame.
+    class SyntheticClientFrameGenerator
+    {
+    public:
+        SyntheticClientFrameGenerator(AZ::u32 clientCount, AZStd::vector<AZ::u32> channelCrcs, AZ::u64 seed);
+
+        //! Appends one frame per client, in client order, and its events in time order.
+        void GenerateFrames(float deltaTime, AZStd::vector<RemoteInputFrame>& frames, AZStd::vector<RemoteInputEvent>& events);
+
+        AZ::u32 GetClientCount() const { return m_clientCount; }
+
+    private:
+        static constexpr AZ::u32 MaxEventsPerFrame = 4;
+
+        AZ::SimpleLcgRandom m_random;
+        AZ::u32 m_clientCount = 0;
+        AZStd::vector<AZ::u32> m_channelCrcs;
+        // Client * channel count + channel -> value the client last sent.
+        AZStd::vector<float> m_channelValues;
+        AZStd::vector<AZ::u32> m_offsets;
+    };
+
+} // namespace EnhancedInput
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Contributors to the Open 3D Engine Project.
+ * For complete copyright and license terms please see the LICENSE at the root of this distribution.
+ *
+ * SPDX-License-Identifier: Apache-2.0 OR MIT
+ *
+ */
+
+#pragma once
+
+#include <AzCore/Math/Vector3.h>
+#include <EnhancedInput/InputTrigger.h>
+
+#include "AllocationTracker.h"
+
+namespace EnhancedInput
+{
+    //! Channel and action values written for many virtual controllers at once, and the action state evaluated from them.
+    //! Every array is column-major: one contiguous run of m_controllerCount values per channel, action or trigger slot,
+    //! so evaluating a binding walks consecutive memory for all controllers, and new channels or actions only append.
+    struct VirtualControllerBatch
+    {
+        AZ::u32 m_controllerCount = 0;
+
+        // Written by the caller; values persist until written again, like a held device channel.
+        RuntimeVector<float> m_channelValues;
+        RuntimeVector<InputValue> m_injectedActionValues;
+        // Channel values as of the previous evaluation, so bindings see releases.
+        RuntimeVector<float> m_previousChannelValues;
+
+        RuntimeVector<InputValue> m_actionValues;
+        RuntimeVector<TriggerState> m_triggerStates;
+        RuntimeVector<float> m_elapsedTimes;
+        RuntimeVector<TriggerRuntimeState> m_triggerRuntimeStates;
+
+        // One action's worth of per-controller scratch.
+        RuntimeVector<AZ::Vector3> m_accumulated;
+        RuntimeVector<TriggerState> m_evaluatedStates;
+        RuntimeVector<AZ::u8> m_hasActiveTriggers;
+        // One binding's trigger pass: the action value each controller's triggers see, which controllers hold the
+        // binding, and the state one trigger reported for each of them.
+        RuntimeVector<InputValue> m_triggerInputs;
+        RuntimeVector<AZ::u8> m_isBindingActive;
+        RuntimeVector<TriggerState> m_triggerResults;
+        // One binding's modifier lanes per controller, padded for RunModifierProgramBatch.
+        RuntimeVector<float> m_modifierLanesX;
+        RuntimeVector<float> m_modifierLanesY;
+        RuntimeVector<float> m_modifierLanesZ;
+    };
+
+} // namespace EnhancedInput
@@ -7,5 +7,804 @@
  */
 
 #include <AzTest/AzTest.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzFramework/Input/Devices/Keyboard/InputDeviceKeyboard.h>
+#include <EnhancedInput/ActionSnapshotCodec.h>
+#include <EnhancedInput/InputMappingContext.h>
+#include <EnhancedInput/InputModifier.h>
+#include <EnhancedInput/InputTrigger.h>
+
+#include "Clients/EnhancedInputSystemComponent.h"
+#include "ActionHistory.h"
+#include "ActionStateStorage.h"
+#include "AllocationTracker.h"
+#include "ChannelStateTable.h"
+#include "ComboAutomaton.h"
+#include "InputRecording.h"
+#include "ModifierBatch.h"
+#include "SyntheticClientFrames.h"
+
+namespace UnitTest
+{
+    using namespace EnhancedInput;
+
+    class EnhancedInputAllocationTest
+        : public LeakDetectionFixture
+    {
+    };
+
+    TEST_F(EnhancedInputAllocationTest, RuntimeVector_Growth_IsCounted)
+    {
+        AllocationTrackingScope scope;
+        RuntimeVector<float> values;
+        values.push_back(1.0f);
+        EXPECT_GT(scope.GetAllocationCount(), 0u);
+    }
+
+    TEST_F(EnhancedInputAllocationTest, ChannelStateTable_SteadyStateTick_DoesNotAllocate)
+    {
+        ChannelIndexMap channelIndices;
+        const ChannelIndex first = channelIndices.RegisterChannel(AZ::Crc32("keyboard_key_alphanumeric_W"));
+        const ChannelIndex second = channelIndices.RegisterChannel(AZ::Crc32("mouse_delta_x"));
+        ChannelStateTable channels;
+        channels.Resize(channelIndices.GetChannelCount());
+
+        AllocationTrackingScope scope;
+        for (int tick = 0; tick < 8; ++tick)
+        {
+            channels.SetValue(first, static_cast<float>(tick % 2));
+            channels.SetValue(second, static_cast<float>(tick));
+            channels.SetValue(second, 0.0f);
+            channels.ClearChanged();
+        }
+        EXPECT_EQ(scope.GetAllocationCount(), 0u);
+    }
+
+    TEST_F(EnhancedInputAllocationTest, ActionStateStorage_ResetAndBuild_DoesNotAllocate)
+    {
+        ActionStateStorage storage;
+        storage.Resize(4);
+
+        AllocationTrackingScope scope;
+        InputActionInstance instance;
+        for (ActionHandle handle = 0; handle < 4; ++handle)
+        {
+            storage.m_values[handle] = InputValue(1.0f);
+            storage.BuildInstance(handle, nullptr, instance);
+            storage.ResetSlot(handle);
+        }
+        EXPECT_EQ(scope.GetAllocationCount(), 0u);
+    }
+
+    // Exposes the requests a test needs to drive the system component's evaluation without the tick bus or devices.
+    class EnhancedInputTestSystemComponent
+        : public EnhancedInputSystemComponent
+    {
+    public:
+        using EnhancedInputSystemComponent::RegisterAction;
+        using EnhancedInputSystemComponent::RegisterCombo;
+        using EnhancedInputSystemComponent::AddMappingContext;
+        using EnhancedInputSystemComponent::AddRemoteClient;
+        using EnhancedInputSystemComponent::EvaluateRemoteFrames;
+        using EnhancedInputSystemComponent::GetRemoteClientActionState;
+    };
+
+    TEST_F(EnhancedInputAllocationTest, EvaluateActions_SteadyStateTicks_DoNotAllocate)
+    {
+        EnhancedInputTestSystemComponent input;
+        const ActionHandle jump = input.RegisterAction("Jump", InputValueType::Axis1D);
+
+        InputActionBinding binding;
+        binding.m_actionName = "Jump";
+        binding.m_inputChannelId = AzFramework::InputDeviceKeyboard::Key::EditSpace;
+        binding.m_modifiers.push_back(AZStd::make_shared<InputModifierScale>(AZ::Vector3(2.0f)));
+        binding.m_triggers.push_back(AZStd::make_shared<InputTriggerHold>(0.05f));
+        auto context = AZStd::make_shared<InputMappingContext>("Gameplay");
+        context->AddBinding(binding);
+        input.AddMappingContext(context);
+        input.AddRemoteClient(0);
+
+        // A press held long enough to fire the hold trigger, then a release, spread over four 16ms frames.
+        const AZ::u32 spaceCrc = static_cast<AZ::u32>(binding.m_inputChannelId.GetNameCrc32());
+        const AZStd::vector<RemoteInputEvent> events = { { spaceCrc, 1.0f, 1000 }, { spaceCrc, 0.0f, 2000 } };
+        const AZStd::vector<RemoteInputFrame> frames = {
+            { 0, 0.016f, 0, 1 },
+            { 0, 0.016f, 1, 0 },
+            { 0, 0.016f, 1, 0 },
+            { 0, 0.016f, 1, 0 },
+            { 0, 0.016f, 1, 1 },
+        };
+
+        // The first pass compiles the context and warms every runtime container up.
+        input.EvaluateRemoteFrames(frames, events);
+
+        AllocationTrackingScope scope;
+        input.EvaluateRemoteFrames(frames, events);
+        EXPECT_EQ(scope.GetAllocationCount(), 0u);
+
+        const InputActionInstance* instance = input.GetRemoteClientActionState(0, jump);
+        ASSERT_NE(instance, nullptr);
+        EXPECT_EQ(instance->m_triggerState, TriggerState::Canceled);
+    }
+
+    class EnhancedInputActionHistoryTest
+        : public LeakDetectionFixture
+    {
+    };
+
+    TEST_F(EnhancedInputActionHistoryTest, ActionHistory_Full_KeepsNewestRecords)
+    {
+        ActionHistory history;
+        history.SetCapacity(2);
+        history.Record(100, TriggerState::Started, InputValue(1.0f), 0.0f);
+        history.Record(200, TriggerState::Triggered, InputValue(1.0f), 0.1f);
+        history.Record(300, TriggerState::Completed, InputValue(), 0.2f);
+
+        ASSERT_EQ(history.GetSize(), 2u);
+        EXPECT_EQ(history[0].m_timeUs, 200);
+        EXPECT_EQ(history[1].m_timeUs, 300);
+        EXPECT_EQ(history.GetLastStateTime(TriggerState::Started), 100);
+    }
+
+    TEST_F(EnhancedInputActionHistoryTest, ActionHistory_ConsumeTriggered_ConsumesEachTriggerOnceWithinWindow)
+    {
+        ActionHistory history;
+        history.SetCapacity(8);
+        history.Record(100, TriggerState::Triggered, InputValue(1.0f), 0.0f);
+        history.Record(200, TriggerState::None, InputValue(), 0.0f);
+        history.Record(300, TriggerState::Triggered, InputValue(1.0f), 0.0f);
+
+        EXPECT_TRUE(history.ConsumeTriggered(150));
+        EXPECT_FALSE(history.ConsumeTriggered(150));
+        EXPECT_TRUE(history.ConsumeTriggered(0));
+    }
+
+    TEST_F(EnhancedInputActionHistoryTest, ActionHistory_Record_DoesNotAllocate)
+    {
+        ActionHistory history;
+        history.SetCapacity(4);
+
+        AllocationTrackingScope scope;
+        for (AZStd::sys_time_t timeUs = 1; timeUs < 16; ++timeUs)
+        {
+            history.Record(timeUs, TriggerState::Triggered, InputValue(1.0f), 0.0f);
+        }
+        EXPECT_EQ(scope.GetAllocationCount(), 0u);
+    }
+
+    TEST_F(EnhancedInputActionHistoryTest, ActionHistory_RestoreState_RewindsRecords)
+    {
+        ActionHistory history;
+        history.SetCapacity(4);
+        history.Record(100, TriggerState::Triggered, InputValue(1.0f), 0.0f);
+
+        AZStd::vector<AZ::u8> state;
+        StateBlobWriter writer(state);
+        history.SaveState(writer);
+
+        history.Record(200, TriggerState::Completed, InputValue(), 0.1f);
+        EXPECT_TRUE(history.ConsumeTriggered(0));
+
+        StateBlobReader reader(state.data(), state.size());
+        ASSERT_TRUE(history.RestoreState(reader));
+        EXPECT_TRUE(reader.IsAtEnd());
+        ASSERT_EQ(history.GetSize(), 1u);
+        EXPECT_EQ(history.GetLastStateTime(TriggerState::Completed), 0);
+        EXPECT_TRUE(history.ConsumeTriggered(0));
+
+        ActionHistory smaller;
+        smaller.SetCapacity(2);
+        StateBlobReader mismatched(state.data(), state.size());
+        EXPECT_FALSE(smaller.RestoreState(mismatched));
+    }
+
+    TEST_F(EnhancedInputActionHistoryTest, ActionStateStorage_SaveAndRestore_DoesNotAllocateOnceWarm)
+    {
+        ActionStateStorage storage;
+        storage.Resize(20);
+        storage.m_values[3] = InputValue(0.5f);
+        storage.m_triggerStates[3] = TriggerState::Ongoing;
+
+        AZStd::vector<AZ::u8> state;
+        {
+            StateBlobWriter writer(state);
+            storage.SaveState(writer);
+        }
+
+        AllocationTrackingScope scope;
+        for (int frame = 0; frame < 8; ++frame)
+        {
+            state.clear();
+            StateBlobWriter writer(state);
+            storage.SaveState(writer);
+
+            storage.m_values[3] = InputValue(1.0f);
+            storage.m_triggerStates[3] = TriggerState::Triggered;
+
+            StateBlobReader reader(state.data(), state.size());
+            ASSERT_TRUE(storage.RestoreState(reader));
+        }
+        EXPECT_EQ(scope.GetAllocationCount(), 0u);
+        EXPECT_EQ(storage.m_values[3].GetAxis1D(), 0.5f);
+        EXPECT_EQ(storage.m_triggerStates[3], TriggerState::Ongoing);
+    }
+
+    class EnhancedInputComboTest
+        : public LeakDetectionFixture
+    {
+    protected:
+        // Actions 0 to 2 are steps; 10 is "0 1 2" and 11 is "1 2", both allowing 100us between steps.
+        void SetUp() override
+        {
+            LeakDetectionFixture::SetUp();
+            AZStd::vector<ComboSequence> sequences;
+            sequences.push_back({ 10, { 0, 1, 2 }, 100 });
+            sequences.push_back({ 11, { 1, 2 }, 100 });
+            m_automaton.Build(sequences, 12);
+            m_automaton.ResetState(m_state);
+            m_completed.reserve(4);
+        }
+
+        void TearDown() override
+        {
+            m_completed = {};
+            m_state = {};
+            m_automaton.Clear();
+            LeakDetectionFixture::TearDown();
+        }
+
+        ComboAutomaton m_automaton;
+        ComboMatchState m_state;
+        RuntimeVector<ActionHandle> m_completed;
+    };
+
+    TEST_F(EnhancedInputComboTest, ComboAutomaton_OverlappingCombos_ReportsLongestOnly)
+    {
+        m_automaton.Advance(m_state, 0, 100, m_completed);
+        m_automaton.Advance(m_state, 1, 150, m_completed);
+        m_automaton.Advance(m_state, 2, 200, m_completed);
+        ASSERT_EQ(m_completed.size(), 1u);
+        EXPECT_EQ(m_completed[0], 10u);
+
+        m_completed.clear();
+        m_automaton.Advance(m_state, 1, 300, m_completed);
+        m_automaton.Advance(m_state, 2, 350, m_completed);
+        ASSERT_EQ(m_completed.size(), 1u);
+        EXPECT_EQ(m_completed[0], 11u);
+    }
+
+    TEST_F(EnhancedInputComboTest, ComboAutomaton_SlowStep_FallsBackToShorterCombo)
+    {
+        m_automaton.Advance(m_state, 0, 100, m_completed);
+        m_automaton.Advance(m_state, 1, 300, m_completed);
+        m_automaton.Advance(m_state, 2, 350, m_completed);
+        ASSERT_EQ(m_completed.size(), 1u);
+        EXPECT_EQ(m_completed[0], 11u);
+    }
+
+    TEST_F(EnhancedInputComboTest, ComboAutomaton_UnrelatedActions_AreIgnored)
+    {
+        AllocationTrackingScope scope;
+        m_automaton.Advance(m_state, 1, 100, m_completed);
+        m_automaton.Advance(m_state, 5, 120, m_completed);
+        m_automaton.Advance(m_state, 0, 140, m_completed);
+        m_automaton.Advance(m_state, 2, 160, m_completed);
+        EXPECT_TRUE(m_completed.empty());
+        EXPECT_EQ(scope.GetAllocationCount(), 0u);
+    }
+
+    TEST_F(EnhancedInputComboTest, RegisterCombo_UnrelatedActionRegisteredMidCombo_KeepsProgress)
+    {
+        EnhancedInputTestSystemComponent input;
+        input.RegisterAction("StepA");
+        input.RegisterAction("StepB");
+        const ActionHandle dash = input.RegisterCombo("Dash", { "StepA", "StepB" }, 1.0f);
+
+        InputActionBinding bindingA;
+        bindingA.m_actionName = "StepA";
+        bindingA.m_inputChannelId = AzFramework::InputDeviceKeyboard::Key::AlphanumericA;
+        InputActionBinding bindingB;
+        bindingB.m_actionName = "StepB";
+        bindingB.m_inputChannelId = AzFramework::InputDeviceKeyboard::Key::AlphanumericB;
+        auto context = AZStd::make_shared<InputMappingContext>("Gameplay");
+        context->AddBinding(bindingA);
+        context->AddBinding(bindingB);
+        input.AddMappingContext(context);
+        input.AddRemoteClient(0);
+
+        const AZ::u32 keyA = static_cast<AZ::u32>(bindingA.m_inputChannelId.GetNameCrc32());
+        const AZ::u32 keyB = static_cast<AZ::u32>(bindingB.m_inputChannelId.GetNameCrc32());
+        const AZStd::vector<RemoteInputEvent> events = { { keyA, 1.0f, 1000 }, { keyA, 0.0f, 1000 }, { keyB, 1.0f, 2000 } };
+        input.EvaluateRemoteFrames({ { 0, 0.016f, 0, 1 } }, events);
+
+        // Registering an action no combo names must not restart the match in progress.
+        input.RegisterAction("Jump");
+        input.EvaluateRemoteFrames({ { 0, 0.016f, 1, 2 } }, events);
+
+        const InputActionInstance* instance = input.GetRemoteClientActionState(0, dash);
+        ASSERT_NE(instance, nullptr);
+        EXPECT_EQ(instance->m_triggerState, TriggerState::Triggered);
+    }
+
+    class EnhancedInputRemoteFrameTest
+        : public LeakDetectionFixture
+    {
+    };
+
+    TEST_F(EnhancedInputRemoteFrameTest, SyntheticClientFrames_SameSeed_GeneratesSameFrames)
+    {
+        SyntheticClientFrameGenerator first(8, { 1, 2, 3 }, 42);
+        SyntheticClientFrameGenerator second(8, { 1, 2, 3 }, 42);
+        AZStd::vector<RemoteInputFrame> firstFrames, secondFrames;
+        AZStd::vector<RemoteInputEvent> firstEvents, secondEvents;
+        for (int frame = 0; frame < 10; ++frame)
+        {
+            first.GenerateFrames(0.016f, firstFrames, firstEvents);
+            second.GenerateFrames(0.016f, secondFrames, secondEvents);
+        }
+
+        ASSERT_EQ(firstFrames.size(), 80u);
+        ASSERT_EQ(firstEvents.size(), secondEvents.size());
+        for (size_t index = 0; index < firstEvents.size(); ++index)
+        {
+            EXPECT_EQ(firstEvents[index].m_channelCrc, secondEvents[index].m_channelCrc);
+            EXPECT_EQ(firstEvents[index].m_value, secondEvents[index].m_value);
+            EXPECT_EQ(firstEvents[index].m_timeOffsetUs, secondEvents[index].m_timeOffsetUs);
+        }
+    }
+
+    TEST_F(EnhancedInputRemoteFrameTest, SyntheticClientFrames_EventsAreOrderedWithinFrame)
+    {
+        SyntheticClientFrameGenerator generator(16, { 1, 2 }, 7);
+        AZStd::vector<RemoteInputFrame> frames;
+        AZStd::vector<RemoteInputEvent> events;
+        generator.GenerateFrames(0.01f, frames, events);
+
+        AZ::u32 nextEvent = 0;
+        for (const RemoteInputFrame& frame : frames)
+        {
+            EXPECT_EQ(frame.m_firstEvent, nextEvent);
+            for (AZ::u32 index = frame.m_firstEvent; index < frame.m_firstEvent + frame.m_eventCount; ++index)
+            {
+                EXPECT_LT(events[index].m_timeOffsetUs, 10000u);
+                if (index > frame.m_firstEvent)
+                {
+                    EXPECT_LE(events[index - 1].m_timeOffsetUs, events[index].m_timeOffsetUs);
+                }
+            }
+            nextEvent += frame.m_eventCount;
+        }
+        EXPECT_EQ(nextEvent, events.size());
+    }
+
+    class EnhancedInputRecordingTest
+        : public LeakDetectionFixture
+    {
+    protected:
+        // Channel 0x12345678 at 1000us, a press of it by user 0 at 1016us, then a 16ms tick at 1012us.
+        const AZStd::vector<AZ::u8> m_recording = {
+            'E', 'I', 'R', 'C', 0x01, 0x00, 0x00, 0x00,
+            0x02, 0xD0, 0x0F, 0x78, 0x56, 0x34, 0x12,
+            0x19, 0x20, 0x00, 0x00,
+            0x00, 0x07, 0x6F, 0x12, 0x83, 0x3C,
+        };
+    };
+
+    TEST_F(EnhancedInputRecordingTest, InputRecordReader_DecodesDeltaEncodedRecords)
+    {
+        InputRecordReader reader;
+        ASSERT_TRUE(reader.Open(m_recording.data(), m_recording.size()));
+
+        InputRecord record;
+        ASSERT_TRUE(reader.Read(record));
+        EXPECT_EQ(record.m_type, InputRecordType::Event);
+        EXPECT_EQ(record.m_timeUs, 1016);
+        EXPECT_EQ(record.m_channelCrc, 0x12345678u);
+        EXPECT_EQ(static_cast<AZ::u32>(record.m_localUserId), 0u);
+        EXPECT_EQ(record.m_value, 1.0f);
+
+        ASSERT_TRUE(reader.Read(record));
+        EXPECT_EQ(record.m_type, InputRecordType::Tick);
+        EXPECT_EQ(record.m_timeUs, 1012);
+        EXPECT_FLOAT_EQ(record.m_deltaTime, 0.016f);
+
+        EXPECT_FALSE(reader.Read(record));
+    }
+
+    TEST_F(EnhancedInputRecordingTest, InputRecordReader_TruncatedRecording_StopsReading)
+    {
+        InputRecordReader reader;
+        ASSERT_TRUE(reader.Open(m_recording.data(), m_recording.size() - 2));
+
+        InputRecord record;
+        EXPECT_TRUE(reader.Read(record));
+        EXPECT_FALSE(reader.Read(record));
+        EXPECT_FALSE(reader.Read(record));
+
+        EXPECT_FALSE(reader.Open(m_recording.data(), 4));
+    }
+
+    TEST_F(EnhancedInputRecordingTest, InputRecordReader_DecodesStateRecords)
+    {
+        // Version 2: a 3 byte state of user 1 at 1000us, then a 16ms tick at the same time.
+        const AZStd::vector<AZ::u8> recording = {
+            'E', 'I', 'R', 'C', 0x02, 0x00, 0x00, 0x00,
+            0x03, 0xD0, 0x0F, 0x01, 0x03, 0xAA, 0xBB, 0xCC,
+            0x00, 0x00, 0x6F, 0x12, 0x83, 0x3C,
+        };
+
+        InputRecordReader reader;
+        ASSERT_TRUE(reader.Open(recording.data(), recording.size()));
+        EXPECT_TRUE(reader.IsAtStateRecord());
+
+        InputRecord record;
+        ASSERT_TRUE(reader.Read(record));
+        EXPECT_EQ(record.m_type, InputRecordType::State);
+        EXPECT_EQ(record.m_timeUs, 1000);
+        EXPECT_EQ(static_cast<AZ::u32>(record.m_localUserId), 1u);
+        ASSERT_EQ(record.m_stateSize, 3u);
+        EXPECT_EQ(record.m_state[0], 0xAA);
+        EXPECT_EQ(record.m_state[2], 0xCC);
+        EXPECT_FALSE(reader.IsAtStateRecord());
+
+        ASSERT_TRUE(reader.Read(record));
+        EXPECT_EQ(record.m_type, InputRecordType::Tick);
+        EXPECT_EQ(record.m_timeUs, 1000);
+
+        EXPECT_FALSE(reader.Read(record));
+    }
+
+    class EnhancedInputSnapshotTest
+        : public LeakDetectionFixture
+    {
+    protected:
+        void SetUp() override
+        {
+            LeakDetectionFixture::SetUp();
+
+            // A typical character: 16 buttons, two triggers and two sticks.
+            m_valueTypes.assign(16, InputValueType::Boolean);
+            m_valueTypes.push_back(InputValueType::Axis1D);
+            m_valueTypes.push_back(InputValueType::Axis1D);
+            m_valueTypes.push_back(InputValueType::Axis2D);
+            m_valueTypes.push_back(InputValueType::Axis2D);
+            m_encoder.Configure(m_valueTypes);
+            m_decoder.Configure(m_valueTypes);
+
+            for (const InputValueType type : m_valueTypes)
+            {
+                InputValue value;
+                value.m_type = type;
+                m_values.push_back(value);
+            }
+            m_triggerStates.assign(m_valueTypes.size(), TriggerState::None);
+            m_decodedValues.resize(m_valueTypes.size());
+            m_decodedStates.resize(m_valueTypes.size());
+            m_buffer.resize(m_encoder.GetMaxSnapshotSize());
+        }
+
+        size_t EncodeAndDecode()
+        {
+            const size_t size = m_encoder.Encode(m_values.data(), m_triggerStates.data(), m_buffer.data(), m_buffer.size());
+            EXPECT_TRUE(m_decoder.Decode(m_buffer.data(), size, m_decodedValues.data(), m_decodedStates.data()));
+            return size;
+        }
+
+        AZStd::vector<InputValueType> m_valueTypes;
+        ActionSnapshotCodec m_encoder;
+        ActionSnapshotCodec m_decoder;
+        AZStd::vector<InputValue> m_values;
+        AZStd::vector<TriggerState> m_triggerStates;
+        AZStd::vector<InputValue> m_decodedValues;
+        AZStd::vector<TriggerState> m_decodedStates;
+        AZStd::vector<AZ::u8> m_buffer;
+    };
+
+    TEST_F(EnhancedInputSnapshotTest, ActionSnapshotCodec_UnchangedFrame_TakesOneByte)
+    {
+        EXPECT_EQ(EncodeAndDecode(), 1u);
+        EXPECT_EQ(EncodeAndDecode(), 1u);
+    }
+
+    TEST_F(EnhancedInputSnapshotTest, ActionSnapshotCodec_TypicalFrame_RoundTripsUnderEightBytes)
+    {
+        m_values[3] = InputValue(true);
+        m_triggerStates[3] = TriggerState::Triggered;
+        m_values[18] = InputValue(AZ::Vector2(0.5f, -1.0f));
+        m_triggerStates[18] = TriggerState::Ongoing;
+
+        EXPECT_LT(EncodeAndDecode(), 8u);
+        EXPECT_TRUE(m_decodedValues[3].GetBool());
+        EXPECT_EQ(m_decodedStates[3], TriggerState::Triggered);
+        EXPECT_NEAR(m_decodedValues[18].GetAxis2D().GetX(), 0.5f, 1.0f / 127.0f);
+        EXPECT_EQ(m_decodedValues[18].GetAxis2D().GetY(), -1.0f);
+        EXPECT_EQ(m_decodedStates[18], TriggerState::Ongoing);
+        EXPECT_EQ(m_decodedValues[19].GetAxis2D().GetX(), 0.0f);
+
+        // Unchanged actions keep their decoded state from the previous snapshot.
+        m_values[18] = InputValue(AZ::Vector2(0.0f, 0.0f));
+        m_triggerStates[18] = TriggerState::Completed;
+        EncodeAndDecode();
+        EXPECT_TRUE(m_decodedValues[3].GetBool());
+        EXPECT_EQ(m_decodedStates[3], TriggerState::Triggered);
+        EXPECT_EQ(m_decodedValues[18].GetAxis2D().GetX(), 0.0f);
+        EXPECT_EQ(m_decodedStates[18], TriggerState::Completed);
+    }
+
+    TEST_F(EnhancedInputSnapshotTest, ActionSnapshotCodec_TruncatedSnapshot_KeepsPreviousState)
+    {
+        m_values[0] = InputValue(true);
+        EncodeAndDecode();
+
+        m_values[0] = InputValue(false);
+        m_values[16] = InputValue(0.25f);
+        const size_t size = m_encoder.Encode(m_values.data(), m_triggerStates.data(), m_buffer.data(), m_buffer.size());
+        EXPECT_FALSE(m_decoder.Decode(m_buffer.data(), size - 1, m_decodedValues.data(), m_decodedStates.data()));
+        EXPECT_TRUE(m_decodedValues[0].GetBool());
+    }
+
+    class EnhancedInputTriggerTimingTest
+        : public LeakDetectionFixture
+    {
+    protected:
+        // Holds the input for the given steps in microseconds and returns how often the trigger fired.
+        static AZ::u32 HoldFor(const InputTrigger& trigger, TriggerRuntimeState& runtimeState, const AZStd::vector<AZ::s64>& stepsUs)
+        {
+            AZ::u32 triggerCount = 0;
+            for (const AZ::s64 stepUs : stepsUs)
+            {
+                TriggerTimeStep timeStep;
+                timeStep.m_deltaTimeUs = stepUs;
+                timeStep.m_deltaTime = static_cast<float>(stepUs) / 1000000.0f;
+                timeStep.m_isDeterministic = true;
+                if (trigger.UpdateState(runtimeState, InputValue(true), timeStep) == TriggerState::Triggered)
+                {
+                    ++triggerCount;
+                }
+            }
+            return triggerCount;
+        }
+    };
+
+    TEST_F(EnhancedInputTriggerTimingTest, InputTriggerHold_DeterministicTiming_FiresAtExactlyTheHoldTime)
+    {
+        const InputTriggerHold hold(0.1f, true);
+
+        TriggerRuntimeState oneStep;
+        EXPECT_EQ(HoldFor(hold, oneStep, { 0, 99999 }), 0u);
+        EXPECT_EQ(HoldFor(hold, oneStep, { 1 }), 1u);
+
+        // Frame times whose float sum falls just short of the hold time still reach it exactly.
+        TriggerRuntimeState slicedSteps;
+        EXPECT_EQ(HoldFor(hold, slicedSteps, { 0, 16667, 16667, 16666, 16667, 16667, 16666 }), 1u);
+        EXPECT_EQ(slicedSteps.m_elapsedUs, oneStep.m_elapsedUs);
+    }
+
+    TEST_F(EnhancedInputTriggerTimingTest, InputTriggerPulse_DeterministicTiming_KeepsPhaseAcrossFrameSizes)
+    {
+        const InputTriggerPulse pulse(0.1f, false);
+
+        TriggerRuntimeState fineSteps;
+        EXPECT_EQ(HoldFor(pulse, fineSteps, AZStd::vector<AZ::s64>(1000, 1000)), 10u);
+
+        // Steps that straddle the interval carry the overshoot instead of restarting the period.
+        TriggerRuntimeState coarseSteps;
+        EXPECT_EQ(HoldFor(pulse, coarseSteps, AZStd::vector<AZ::s64>(30, 33333)), 9u);
+        EXPECT_EQ(HoldFor(pulse, coarseSteps, { 10 }), 1u);
+        EXPECT_EQ(coarseSteps.m_elapsedUs, fineSteps.m_elapsedUs);
+    }
+
+    TEST_F(EnhancedInputTriggerTimingTest, InputTriggerPulse_DeterministicTiming_CountsEveryPeriodOfALongStep)
+    {
+        const InputTriggerPulse pulse(0.1f, false);
+
+        TriggerRuntimeState runtimeState;
+        EXPECT_EQ(HoldFor(pulse, runtimeState, { 0, 350000 }), 1u);
+        EXPECT_EQ(runtimeState.m_periodCount, 3u);
+        EXPECT_EQ(runtimeState.m_elapsedUs, 50000);
+
+        EXPECT_EQ(HoldFor(pulse, runtimeState, { 10000 }), 0u);
+        EXPECT_EQ(runtimeState.m_periodCount, 0u);
+    }
+
+    class EnhancedInputModifierProgramTest
+        : public LeakDetectionFixture
+    {
+    protected:
+        static AZ::Vector3 ApplyChain(const AZStd::vector<InputModifierPtr>& modifiers, const InputValue& value)
+        {
+            InputValue result = value;
+            for (const auto& modifier : modifiers)
+            {
+                result = modifier->ModifyValue(result);
+            }
+            return result.GetAxis3D();
+        }
+    };
+
+    TEST_F(EnhancedInputModifierProgramTest, ModifierProgram_LinearModifiers_FuseIntoOneOp)
+    {
+        const AZStd::vector<InputModifierPtr> modifiers = {
+            AZStd::make_shared<InputModifierDeadZone>(0.2f, 0.9f, InputModifierDeadZone::DeadZoneType::Radial),
+            AZStd::make_shared<InputModifierScale>(AZ::Vector3(0.5f, 2.0f, -1.0f)),
+            AZStd::make_shared<InputModifierSwizzle>(InputModifierSwizzle::SwizzleOrder::ZXY),
+            AZStd::make_shared<InputModifierNegate>(true, false, true),
+            AZStd::make_shared<InputModifierClamp>(-0.75f, 0.75f),
+            AZStd::make_shared<InputModifierNegate>(),
+            AZStd::make_shared<InputModifierNegate>(),
+            AZStd::make_shared<InputModifierNormalize>(),
+        };
+
+        AZStd::vector<ModifierOp> ops;
+        ModifierProgramBuilder builder(ops);
+        builder.AddChain(modifiers);
+
+        // Dead zone, the fused Scale-Swizzle-Negate matrix, clamp and normalize; the two negates cancel out.
+        ASSERT_EQ(builder.GetOpCount(), 4u);
+        EXPECT_EQ(ops[1].m_code, ModifierOpCode::Linear);
+
+        for (const float rawValue : { -1.0f, -0.5f, 0.0f, 0.1f, 0.3f, 0.6f, 1.0f })
+        {
+            const InputValue value(rawValue);
+            EXPECT_TRUE(RunModifierProgram(ops.data(), builder.GetOpCount(), value).IsClose(ApplyChain(modifiers, value)));
+        }
+    }
+
+    TEST_F(EnhancedInputModifierProgramTest, ModifierProgram_SeparateChains_AreNotFused)
+    {
+        const AZStd::vector<InputModifierPtr> first = { AZStd::make_shared<InputModifierNegate>() };
+        const AZStd::vector<InputModifierPtr> second = { AZStd::make_shared<InputModifierScale>(AZ::Vector3(3.0f)) };
+
+        AZStd::vector<ModifierOp> ops;
+        ModifierProgramBuilder firstBuilder(ops);
+        firstBuilder.AddChain(first);
+        ModifierProgramBuilder secondBuilder(ops);
+        secondBuilder.AddChain(second);
+
+        ASSERT_EQ(ops.size(), 2u);
+        EXPECT_EQ(secondBuilder.GetFirstOp(), 1u);
+        EXPECT_TRUE(RunModifierProgram(ops.data() + 1, 1, InputValue(0.5f)).IsClose(AZ::Vector3(1.5f)));
+    }
+
+    TEST_F(EnhancedInputModifierProgramTest, ModifierProgramBatch_MatchesScalarModifiers)
+    {
+        // Sixteen values, including zero and both sides of the dead zone, over a lane count that is not padded.
+        constexpr size_t LaneCount = 15;
+        const size_t paddedLaneCount = GetPaddedLaneCount(LaneCount);
+        AZStd::vector<float> values(paddedLaneCount);
+        for (size_t lane = 0; lane < paddedLaneCount; ++lane)
+        {
+            values[lane] = -1.2f + 0.16f * static_cast<float>(lane);
+        }
+
+        const AZStd::vector<AZStd::vector<InputModifierPtr>> chains = {
+            { AZStd::make_shared<InputModifierDeadZone>(0.2f, 0.9f), AZStd::make_shared<InputModifierNegate>() },
+            { AZStd::make_shared<InputModifierScale>(AZ::Vector3(0.5f, -2.0f, 1.0f)),
+              AZStd::make_shared<InputModifierDeadZone>(0.25f, 1.0f, InputModifierDeadZone::DeadZoneType::Radial),
+              AZStd::make_shared<InputModifierClamp>(-0.5f, 0.5f) },
+            { AZStd::make_shared<InputModifierScale>(AZ::Vector3(1.0f, 1.0f, 0.0f)),
+              AZStd::make_shared<InputModifierSwizzle>(InputModifierSwizzle::SwizzleOrder::YZX),
+              AZStd::make_shared<InputModifierNormalize>() },
+        };
+
+        for (const auto& chain : chains)
+        {
+            AZStd::vector<ModifierOp> ops;
+            ModifierProgramBuilder builder(ops);
+            builder.AddChain(chain);
+
+            AZStd::vector<float> x(values), y(paddedLaneCount, 1.0f), z(paddedLaneCount, 1.0f);
+            RunModifierProgramBatch(ops.data(), builder.GetOpCount(), x.data(), y.data(), z.data(), LaneCount);
+            for (size_t lane = 0; lane < LaneCount; ++lane)
+            {
+                const AZ::Vector3 expected = ApplyChain(chain, InputValue(values[lane]));
+                EXPECT_TRUE(AZ::Vector3(x[lane], y[lane], z[lane]).IsClose(expected, 1.0e-5f)) << "lane " << lane;
+            }
+        }
+    }
+
+#if defined(HAVE_BENCHMARK)
+    //! Typical stick chain, evaluated for as many lanes as a large batch of virtual controllers.
+    class EnhancedInputModifierBenchmark
+        : public AllocatorsBenchmarkFixture
+    {
+    public:
+        static constexpr size_t LaneCount = 1024;
+
+        void SetUp(const benchmark::State& state) override
+        {
+            AllocatorsBenchmarkFixture::SetUp(state);
+            m_modifiers = {
+                AZStd::make_shared<InputModifierScale>(AZ::Vector3(1.0f, 0.5f, 0.0f)),
+                AZStd::make_shared<InputModifierDeadZone>(0.2f, 0.95f, InputModifierDeadZone::DeadZoneType::Radial),
+                AZStd::make_shared<InputModifierNegate>(false, true, false),
+                AZStd::make_shared<InputModifierClamp>(-0.8f, 0.8f),
+                AZStd::make_shared<InputModifierNormalize>(),
+            };
+            ModifierProgramBuilder builder(m_ops);
+            builder.AddChain(m_modifiers);
+
+            m_values.resize(GetPaddedLaneCount(LaneCount));
+            for (size_t lane = 0; lane < m_values.size(); ++lane)
+            {
+                m_values[lane] = static_cast<float>(lane % 200) / 100.0f - 1.0f;
+            }
+            m_x.resize(m_values.size());
+            m_y.resize(m_values.size());
+            m_z.resize(m_values.size());
+        }
+
+        void SetUp(benchmark::State& state) override
+        {
+            SetUp(AZStd::as_const(state));
+        }
+
+        void TearDown(const benchmark::State& state) override
+        {
+            m_modifiers = {};
+            m_ops = {};
+            m_values = {};
+            m_x = {};
+            m_y = {};
+            m_z = {};
+            AllocatorsBenchmarkFixture::TearDown(state);
+        }
+
+        void TearDown(benchmark::State& state) override
+        {
+            TearDown(AZStd::as_const(state));
+        }
+
+    protected:
+        AZStd::vector<InputModifierPtr> m_modifiers;
+        AZStd::vector<ModifierOp> m_ops;
+        AZStd::vector<float> m_values;
+        AZStd::vector<float> m_x;
+        AZStd::vector<float> m_y;
+        AZStd::vector<float> m_z;
+    };
+
+    BENCHMARK_F(EnhancedInputModifierBenchmark, ScalarModifyValue)(benchmark::State& state)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (size_t lane = 0; lane < LaneCount; ++lane)
+            {
+                InputValue value(m_values[lane]);
+                for (const auto& modifier : m_modifiers)
+                {
+                    value = modifier->ModifyValue(value);
+                }
+                benchmark::DoNotOptimize(value);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * LaneCount);
+    }
+
+    BENCHMARK_F(EnhancedInputModifierBenchmark, CompiledProgram)(benchmark::State& state)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (size_t lane = 0; lane < LaneCount; ++lane)
+            {
+                benchmark::DoNotOptimize(RunModifierProgram(m_ops.data(), static_cast<AZ::u32>(m_ops.size()), InputValue(m_values[lane])));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * LaneCount);
+    }
+
+    BENCHMARK_F(EnhancedInputModifierBenchmark, SimdBatch)(benchmark::State& state)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            AZStd::copy(m_values.begin(), m_values.end(), m_x.begin());
+            RunModifierProgramBatch(m_ops.data(), static_cast<AZ::u32>(m_ops.size()), m_x.data(), m_y.data(), m_z.data(), LaneCount);
+            benchmark::DoNotOptimize(m_x.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * LaneCount);
+    }
+#endif
+} // namespace UnitTest
 
 AZ_UNIT_TEST_HOOK(DEFAULT_UNIT_TEST_ENV);
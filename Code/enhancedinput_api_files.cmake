@@ -11,4 +11,5 @@ set(FILES
     Include/EnhancedInput/PlayerInputComponent.h
     Include/EnhancedInput/EnhancedInputLuaHelper.h
     Include/EnhancedInput/InputTypes.h
+    Include/EnhancedInput/ActionSnapshotCodec.h
 )
@@ -4,6 +4,28 @@ set(FILES
     Source/EnhancedInputModuleInterface.h
     Source/Clients/EnhancedInputSystemComponent.cpp
     Source/Clients/EnhancedInputSystemComponent.h
+    Source/AllocationTracker.cpp
+    Source/AllocationTracker.h
+    Source/ActionHistory.cpp
+    Source/ActionHistory.h
+    Source/ActionSnapshotCodec.cpp
+    Source/ActionStateStorage.cpp
+    Source/ActionStateStorage.h
+    Source/ChannelStateTable.cpp
+    Source/ChannelStateTable.h
+    Source/ComboAutomaton.cpp
+    Source/ComboAutomaton.h
+    Source/InputEventQueue.h
+    Source/InputPipeline.h
+    Source/InputRecording.cpp
+    Source/InputRecording.h
+    Source/ModifierBatch.cpp
+    Source/ModifierBatch.h
+    Source/SpscQueue.h
+    Source/StateBlob.h
+    Source/SyntheticClientFrames.cpp
+    Source/SyntheticClientFrames.h
+    Source/VirtualControllerBatch.h
     Source/InputTrigger.cpp
     Source/InputModifier.cpp
     Source/InputMappingContext.cpp